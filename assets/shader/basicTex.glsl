@@ -9,11 +9,14 @@ uniform mat4 uModelMat;
 uniform mat4 uProjMat;
 
 out vec2 fTex;
+out vec2 fWorldPos;
 
 void main()
 {
+    vec4 worldPos = uModelMat * vec4(vPos.xyz, 1.0);
     fTex = vTex;
-    gl_Position = uProjMat * uModelMat * vec4(vPos.xyz, 1.0);
+    fWorldPos = worldPos.xy;
+    gl_Position = uProjMat * worldPos;
 }
 
 /// frag ///
@@ -26,8 +29,10 @@ uniform vec4 uBorderSize = vec4(0);
 uniform vec4 uBorderRadii = vec4(0);
 uniform vec2 uResolution;
 uniform int uUseTexture = 1;
+uniform vec4 uClipRect;
 
 in vec2 fTex;
+in vec2 fWorldPos;
 
 float roundedBoxSDF(vec2 uv, vec2 size, vec4 radii)
 {
@@ -38,6 +43,14 @@ float roundedBoxSDF(vec2 uv, vec2 size, vec4 radii)
 
 void main()
 {
+    /* Clip against the viewable area of the node. Same rule as glScissor: pixel centers outside the
+       [pos, pos + scale) rectangle are dropped. */
+    if (fWorldPos.x < uClipRect.x || fWorldPos.x >= uClipRect.x + uClipRect.z
+        || fWorldPos.y < uClipRect.y || fWorldPos.y >= uClipRect.y + uClipRect.w)
+    {
+        discard;
+    }
+
     // gl_FragColor = color;
 
     vec2 p = fTex;
@@ -8,11 +8,14 @@ uniform mat4 uModelMat;
 uniform mat4 uProjMat;
 
 out vec2 fTex;
+out vec2 fWorldPos;
 
 void main()
 {
+    vec4 worldPos = uModelMat * vec4(vPos, 1.0f);
     fTex = vTex;
-    gl_Position = uProjMat * uModelMat * vec4(vPos, 1.0f);
+    fWorldPos = worldPos.xy;
+    gl_Position = uProjMat * worldPos;
 }
 
 /// frag ///
@@ -23,8 +26,10 @@ uniform vec4 uBorderColor = vec4(0.0, 0.0, 1.0, 1.0);
 uniform vec4 uBorderSize = vec4(0);
 uniform vec4 uBorderRadii = vec4(0);
 uniform vec2 uResolution;
+uniform vec4 uClipRect;
 
 in vec2 fTex;
+in vec2 fWorldPos;
 
 /**
     Compute sdf of a box whose corners can be rounded individually.
@@ -42,6 +47,14 @@ float roundedBoxSDF(vec2 uv, vec2 halfSize, vec4 radii)
 
 void main()
 {
+    /* Clip against the viewable area of the node. Same rule as glScissor: pixel centers outside the
+       [pos, pos + scale) rectangle are dropped. */
+    if (fWorldPos.x < uClipRect.x || fWorldPos.x >= uClipRect.x + uClipRect.z
+        || fWorldPos.y < uClipRect.y || fWorldPos.y >= uClipRect.y + uClipRect.w)
+    {
+        discard;
+    }
+
     vec2 p = fTex;
     p.x *= uResolution.x;
     p.y *= uResolution.y;
@@ -0,0 +1,119 @@
+/// vertex ///
+#version 330 core
+
+layout (location = 0) in vec3 vPos;
+layout (location = 1) in vec2 vTex;
+
+/* Per instance attributes */
+layout (location = 2) in vec3 iPos;
+layout (location = 3) in vec2 iScale;
+layout (location = 4) in vec4 iColor;
+layout (location = 5) in vec4 iBorderColor;
+layout (location = 6) in vec4 iBorderSize;
+layout (location = 7) in vec4 iBorderRadii;
+layout (location = 8) in vec4 iClipRect;
+
+uniform mat4 uProjMat;
+
+out vec2 fTex;
+out vec2 fWorldPos;
+flat out vec4 fColor;
+flat out vec4 fBorderColor;
+flat out vec4 fBorderSize;
+flat out vec4 fBorderRadii;
+flat out vec4 fClipRect;
+flat out vec2 fResolution;
+
+void main()
+{
+    fTex = vTex;
+    fWorldPos = iPos.xy + vPos.xy * iScale;
+    fColor = iColor;
+    fBorderColor = iBorderColor;
+    fBorderSize = iBorderSize;
+    fBorderRadii = iBorderRadii;
+    fClipRect = iClipRect;
+    fResolution = iScale;
+    gl_Position = uProjMat * vec4(fWorldPos, iPos.z, 1.0f);
+}
+
+/// frag ///
+#version 330 core
+
+in vec2 fTex;
+in vec2 fWorldPos;
+flat in vec4 fColor;
+flat in vec4 fBorderColor;
+flat in vec4 fBorderSize;
+flat in vec4 fBorderRadii;
+flat in vec4 fClipRect;
+flat in vec2 fResolution;
+
+/**
+    Compute sdf of a box whose corners can be rounded individually.
+
+    @param uv Uv coord
+    @param halfSize Half size of the box
+    @radii top/bot/left/right sizes of the corner radii
+*/
+float roundedBoxSDF(vec2 uv, vec2 halfSize, vec4 radii)
+{
+    vec2 absPos = abs(uv) - halfSize;
+    float radius = uv.x > 0 ? (uv.y > 0 ? radii.z : radii.y) : (uv.y > 0 ? radii.w : radii.x);
+    return length(max(absPos + radius, 0.0)) - radius;
+}
+
+void main()
+{
+    /* Clip against the viewable area of the node. Same rule as glScissor: pixel centers outside the
+       [pos, pos + scale) rectangle are dropped. */
+    if (fWorldPos.x < fClipRect.x || fWorldPos.x >= fClipRect.x + fClipRect.z
+        || fWorldPos.y < fClipRect.y || fWorldPos.y >= fClipRect.y + fClipRect.w)
+    {
+        discard;
+    }
+
+    vec2 p = fTex;
+    p.x *= fResolution.x;
+    p.y *= fResolution.y;
+    p -= vec2(fResolution.x / 2.0, fResolution.y / 2.0);
+
+    /* Wanted size of the outside box. */
+    vec2 outerBoxSize = vec2(fResolution.x, fResolution.y);
+
+    /* Size of the content after the borders are in place. */
+    vec2 contentSize = vec2(fResolution.x, fResolution.y);
+    contentSize -= vec2(fBorderSize.z + fBorderSize.w, fBorderSize.x + fBorderSize.y);
+
+    /* Center of the inner box aka the box formed after applying the border sizes for the outer box.*/
+    vec2 innerBoxCenter = vec2(
+        ((fBorderSize.z + fBorderSize.w) * 0.5) - fBorderSize.w - 0,
+        ((fBorderSize.x + fBorderSize.y) * 0.5) - fBorderSize.y);
+
+    /* Invert inner border radius..for some reason. */
+    vec4 innerBorderRadius = fBorderRadii;
+    float temp = innerBorderRadius.z;
+    innerBorderRadius.z = innerBorderRadius.x;
+    innerBorderRadius.x = temp;
+
+    temp = innerBorderRadius.w;
+    innerBorderRadius.w = innerBorderRadius.y;
+    innerBorderRadius.y = temp;
+
+    float outerBoxDist = roundedBoxSDF(p, (outerBoxSize / 2.0), fBorderRadii);
+    float innerBoxDist = roundedBoxSDF((innerBoxCenter) - p, (contentSize / 2.0), innerBorderRadius / 2.0f);
+
+    float outerBoxSdf = step(0.0001, outerBoxDist);
+    float innerBoxSdf = step(0.0001, innerBoxDist);
+    float inOutDiffSdf = innerBoxSdf - outerBoxSdf;
+
+    if (outerBoxSdf >= 1) { discard; }
+
+    /* Set the color of the inner content */
+    vec4 finalColor = mix(fColor, vec4(0.0), innerBoxSdf);
+
+    /* Set the color of the border */
+    finalColor += mix(vec4(0.0), fBorderColor, inOutDiffSdf);
+
+    gl_FragColor = finalColor;
+}
\ No newline at end of file
@@ -3,35 +3,71 @@
 
 layout (location = 0) in vec3 vPos;
 layout (location = 1) in vec2 vTex;
-layout (location = 2) in vec3 vCol;
 
-uniform mat4[256] uModelMatv;
+/* Per instance attributes */
+layout (location = 2) in vec3 iPos;
+layout (location = 3) in uint iGlyphAndText;
+
 uniform mat4 uProjMat;
+uniform sampler2D uAtlas;
+
+/* One texel per atlas slot: texel rect (x, y, w, h) of the glyph. */
+uniform isamplerBuffer uGlyphRectv;
+
+/* Three texels per text: color, clip rect & font params (glyph scale, is SDF). */
+uniform samplerBuffer uTextDatav;
 
 out vec2 fTex;
-flat out int instanceId;
+out vec2 fWorldPos;
+flat out vec4 fColor;
+flat out vec4 fClipRect;
+flat out float fIsSdf;
 
 void main()
 {
-    fTex = vTex;
-    instanceId = gl_InstanceID;
-    gl_Position = uProjMat * uModelMatv[gl_InstanceID] * vec4(vPos.xyz, 1.0);
+    int textIdx = int(iGlyphAndText >> 16u);
+    vec4 glyphRect = vec4(texelFetch(uGlyphRectv, int(iGlyphAndText & 0xFFFFu)));
+    vec4 fontParams = texelFetch(uTextDatav, textIdx * 3 + 2);
+
+    /* SDF glyphs are stored at the reference size and scaled to the size of the text. */
+    vec2 worldPos = iPos.xy + vPos.xy * glyphRect.zw * fontParams.x;
+
+    fTex = (glyphRect.xy + vTex * glyphRect.zw) / vec2(textureSize(uAtlas, 0));
+    fWorldPos = worldPos;
+    fColor = texelFetch(uTextDatav, textIdx * 3);
+    fClipRect = texelFetch(uTextDatav, textIdx * 3 + 1);
+    fIsSdf = fontParams.y;
+    gl_Position = uProjMat * vec4(worldPos, iPos.z, 1.0);
 }
 
 /// frag ///
 #version 330 core
 
-uniform sampler2DArray uTextureArray;
-uniform int[256] uCharIdxv;
-uniform vec4 uColor;
+uniform sampler2D uAtlas;
 
 in vec2 fTex;
-flat in int instanceId;
+in vec2 fWorldPos;
+flat in vec4 fColor;
+flat in vec4 fClipRect;
+flat in float fIsSdf;
 
 void main()
 {
-    int zSliceIndex = uCharIdxv[instanceId];
-    float t = texture(uTextureArray, vec3(fTex, zSliceIndex)).r;
+    /* Clip against the viewable area of the text's parent node. */
+    if (fWorldPos.x < fClipRect.x || fWorldPos.x >= fClipRect.x + fClipRect.z
+        || fWorldPos.y < fClipRect.y || fWorldPos.y >= fClipRect.y + fClipRect.w)
+    {
+        discard;
+    }
+
+    float t = texture(uAtlas, fTex).r;
+
+    /* Edge sits at 0.5 in distance fields. Smoothing over one screen pixel keeps it crisp at any scale. */
+    if (fIsSdf > 0.5)
+    {
+        float w = fwidth(t);
+        t = smoothstep(0.5 - w, 0.5 + w, t);
+    }
 
-    gl_FragColor = vec4(uColor.xyz, t);
+    gl_FragColor = vec4(fColor.xyz, t);
 }
\ No newline at end of file
@@ -24,6 +24,9 @@ if [[ -z $1 ]]; then
     echo "[INFO ] contextmenu"
     echo "[INFO ] treeViews"
     echo "[INFO ] buttonWithDecorations"
+    echo "[INFO ] nodeBench"
+    echo "[INFO ] glyphEviction"
+    echo "[INFO ] glyphAtlasReuse"
     exit
 fi
 
@@ -0,0 +1,83 @@
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <GL/glew.h>
+
+#include "msgui/Application.hpp"
+#include "msgui/Logger.hpp"
+#include "msgui/Utils.hpp"
+#include "msgui/loaders/BELoadingQueue.hpp"
+#include "msgui/node/Box.hpp"
+#include "msgui/node/WindowFrame.hpp"
+#include "msgui/renderer/GlyphAtlas.hpp"
+
+using namespace msgui;
+
+int main()
+{
+    /*
+        Not really an example but a check for glyph slot reuse in the atlas. A glyph gets evicted and a smaller one
+        takes over its slot & texels. Everything the new glyph doesn't cover, its padding included, needs to read as
+        zero, otherwise linear filtering at its edges blends in the evicted glyph. Exits with 0 on success.
+    */
+    Application& app = Application::get();
+    if (!app.init()) { return 1; }
+
+    Logger mainLogger("mainLog");
+
+    WindowFramePtr& window = app.createFrame("MainWindow", 1280, 720);
+
+    BoxPtr rootBox = window->getRoot();
+    rootBox->setColor(Utils::hexToVec4("#4aabebff"));
+
+    /* Runs on the UI thread with the GL context current. */
+    loaders::BELoadingQueue::get().pushTask(loaders::VoidTask([&mainLogger]()
+    {
+        renderer::GlyphAtlas& atlas = renderer::GlyphAtlas::get();
+
+        const glm::ivec2 evictedSize{10, 10};
+        const std::vector<uint8_t> evictedPixels(evictedSize.x * evictedSize.y, 255);
+        glm::ivec4 evictedRect;
+        const uint32_t evictedSlot = atlas.addGlyph(evictedSize, evictedPixels.data(), evictedRect);
+        atlas.removeGlyph(evictedSlot);
+
+        const glm::ivec2 reusingSize{6, 6};
+        const std::vector<uint8_t> reusingPixels(reusingSize.x * reusingSize.y, 128);
+        glm::ivec4 reusingRect;
+        const uint32_t reusingSlot = atlas.addGlyph(reusingSize, reusingPixels.data(), reusingRect);
+
+        bool isOk = reusingSlot == evictedSlot && reusingRect.x == evictedRect.x && reusingRect.y == evictedRect.y;
+        if (!isOk) { mainLogger.errorLn("Evicted slot or texels did not get reused"); }
+
+        const glm::ivec2 atlasSize = atlas.getSize();
+        std::vector<uint8_t> texels(atlasSize.x * atlasSize.y);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glBindTexture(GL_TEXTURE_2D, atlas.getTexId());
+        glGetTexImage(GL_TEXTURE_2D, 0, GL_RED, GL_UNSIGNED_BYTE, texels.data());
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        /* Whole padded area of the evicted glyph, the reusing one shall be the only thing left in it. */
+        for (int32_t y = evictedRect.y; isOk && y <= evictedRect.y + evictedRect.w; y++)
+        {
+            for (int32_t x = evictedRect.x; isOk && x <= evictedRect.x + evictedRect.z; x++)
+            {
+                const bool isReusing = x < reusingRect.x + reusingRect.z && y < reusingRect.y + reusingRect.w;
+                const uint8_t texel = texels[y * atlasSize.x + x];
+                isOk = texel == (isReusing ? 128 : 0);
+                if (!isOk) { mainLogger.errorLn("Stale texel %d at %d,%d", (int32_t)texel, x, y); }
+            }
+        }
+
+        if (isOk) { mainLogger.infoLn("Glyph atlas reuse check passed"); }
+        exit(isOk ? 0 : 1);
+    }));
+
+    app.setPollMode(Application::PollMode::ON_EVENT);
+    app.setVSync(true);
+
+    /* Blocks from here on */
+    app.run();
+
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include <cstdlib>
+#include <functional>
+#include <string>
+
+#include "msgui/Application.hpp"
+#include "msgui/Logger.hpp"
+#include "msgui/Utils.hpp"
+#include "msgui/loaders/BELoadingQueue.hpp"
+#include "msgui/loaders/FontLoader.hpp"
+#include "msgui/node/Box.hpp"
+#include "msgui/node/TextLabel.hpp"
+#include "msgui/node/WindowFrame.hpp"
+
+using namespace msgui;
+
+namespace
+{
+/* Text that gets hidden, plus its codepoints to check the laid out glyphs against. All of them are lazy glyphs. */
+const std::string HIDDEN_TEXT = "Привет";
+const std::u32string HIDDEN_CODEPOINTS = U"Привет";
+
+/* Enough other lazy glyphs to push the hidden text's ones out of the tiny cache. */
+const std::string EVICTING_TEXT = "ΑΒΓΔΕΖΗΘΙΚΛΜΝΞΟΠΡΣΤΥΦΧΨΩαβγδεζηθικλμνξοπρστυφχψωЖЗЙЛФЦЧШЩЫЭЮЯжзйлфцчшщыэюя";
+
+/* Run the next step on the UI thread once the current frame is done. */
+void nextStep(std::function<void()> step)
+{
+    loaders::BELoadingQueue::get().pushTask(loaders::VoidTask(std::move(step)));
+}
+
+void setShown(const BoxPtr& box, const bool shown)
+{
+    box->getLayout().setScale({300, shown ? 40 : 0});
+}
+} // namespace
+
+int main()
+{
+    /*
+        Not really an example but a check for lazy glyph eviction. A text gets hidden without its transform changing,
+        another text evicts its glyphs from the atlas, then the first one is shown again. Its glyphs need to point to
+        the atlas slots of its own codepoints, not to whatever took over the evicted slots. Exits with 0 on success.
+    */
+    Application& app = Application::get();
+    if (!app.init()) { return 1; }
+
+    app.setGlyphCacheBudget(2048);
+
+    Logger mainLogger("mainLog");
+
+    WindowFramePtr& window = app.createFrame("MainWindow", 1280, 720);
+
+    BoxPtr rootBox = window->getRoot();
+    rootBox->setColor(Utils::hexToVec4("#4aabebff"));
+    rootBox->getLayout().setType(Layout::Type::VERTICAL);
+
+    /* Labels are hidden by collapsing their container, so their own position & scale stay the same. */
+    BoxPtr hiddenBox = Utils::make<Box>("HiddenBox");
+    BoxPtr evictingBox = Utils::make<Box>("EvictingBox");
+    TextLabelPtr hiddenLbl = Utils::make<TextLabel>("HiddenLabel");
+    TextLabelPtr evictingLbl = Utils::make<TextLabel>("EvictingLabel");
+    hiddenLbl->setText(HIDDEN_TEXT);
+    evictingLbl->setText(EVICTING_TEXT);
+    for (const auto& [box, lbl] : {std::pair{hiddenBox, hiddenLbl}, std::pair{evictingBox, evictingLbl}})
+    {
+        lbl->getLayout().setScale({300, 40});
+        box->append(lbl);
+        rootBox->append(box);
+    }
+    setShown(evictingBox, false);
+
+    /* Tasks run before the frames of a loop, the first frame needs to be laid out before starting. */
+    nextStep([&]() { nextStep([&]()
+    {
+        const renderer::TextData& hiddenData = *hiddenLbl->getTextData().value();
+        const glm::vec3 laidOutPos = hiddenData.laidOutPos;
+        const glm::vec3 laidOutScale = hiddenData.laidOutScale;
+        setShown(hiddenBox, false);
+        setShown(evictingBox, true);
+
+        nextStep([&, laidOutPos, laidOutScale]()
+        {
+            const uint64_t evictionCount = loaders::FontLoader::get().getEvictionCount();
+            setShown(hiddenBox, true);
+            setShown(evictingBox, false);
+
+            nextStep([&, laidOutPos, laidOutScale, evictionCount]()
+            {
+                const renderer::TextData& data = *hiddenLbl->getTextData().value();
+                if (evictionCount == 0) { mainLogger.warnLn("Nothing got evicted, check is meaningless"); }
+                if (data.laidOutPos != laidOutPos || data.laidOutScale != laidOutScale)
+                {
+                    mainLogger.warnLn("Hidden text got moved, layout would have been redone anyway");
+                }
+
+                bool isOk = data.pcd.glyphs.size() == HIDDEN_CODEPOINTS.size();
+                loaders::FontLoader& fontLoader = loaders::FontLoader::get();
+                for (size_t i = 0; isOk && i < HIDDEN_CODEPOINTS.size(); i++)
+                {
+                    isOk = data.pcd.glyphs[i].glyphAndText
+                        == fontLoader.getCodePoint(*data.fontData, HIDDEN_CODEPOINTS[i]).atlasSlot;
+                }
+
+                isOk ? mainLogger.infoLn("Glyph eviction check passed")
+                    : mainLogger.errorLn("Shown again text still uses evicted atlas slots");
+                exit(isOk ? 0 : 1);
+            });
+        });
+    }); });
+
+    app.setPollMode(Application::PollMode::ON_EVENT);
+    app.setVSync(true);
+
+    /* Blocks from here on */
+    app.run();
+
+    return 0;
+}
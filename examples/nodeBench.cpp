@@ -0,0 +1,390 @@
+#include <array>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <GLFW/glfw3.h>
+
+#include "msgui/Application.hpp"
+#include "msgui/Logger.hpp"
+#include "msgui/Utils.hpp"
+#include "msgui/node/Box.hpp"
+#include "msgui/node/Button.hpp"
+#include "msgui/node/NodeRegistry.hpp"
+#include "msgui/node/WindowFrame.hpp"
+#include "msgui/events/LMBRelease.hpp"
+#include "msgui/events/NodeEventManager.hpp"
+#include "msgui/layoutEngine/utils/ViewableAreaBatch.hpp"
+
+using namespace msgui;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+double elapsedNs(const Clock::time_point start)
+{
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+/* Event nobody else listens to, so dispatching it only costs what the event manager itself does. */
+struct BenchEvent : public events::INEvent
+{
+    int32_t value{1};
+};
+
+/* Same thing a RecycleList does when its visible rows get rebuilt: a batch of buttons is created, set up and
+   thrown away. */
+template<typename MakeFunc>
+double benchChurn(const MakeFunc& makeFunc, const int32_t rounds, const int32_t rowsPerRound)
+{
+    std::vector<ButtonPtr> rows;
+    rows.reserve(rowsPerRound);
+
+    const Clock::time_point start = Clock::now();
+    for (int32_t round = 0; round < rounds; round++)
+    {
+        for (int32_t i = 0; i < rowsPerRound; i++)
+        {
+            ButtonPtr row = makeFunc();
+            row->getLayout().setScaleType({Layout::ScaleType::REL, Layout::ScaleType::PX}).setScale({1.0f, 20});
+            rows.emplace_back(std::move(row));
+        }
+        rows.clear();
+    }
+    return elapsedNs(start) / (rounds * rowsPerRound);
+}
+
+/* Transform as it used to live inside of every node, before the TransformStore took its fields out. */
+struct NodeResidentTransform
+{
+    glm::vec3 pos{0, 0, 1};
+    glm::vec3 scale{1};
+    glm::ivec2 vPos{0};
+    glm::ivec2 vScale{0};
+    glm::mat4 modelMatrix{1.0f};
+};
+
+/* Stand-in for a pre-store node: its transform sits right before the layout, the rest of the node's fields are a
+   blob of the same size a Box carries today. Keeps hot fields as far apart in memory as they used to be. */
+struct NodeResidentBox
+{
+    NodeResidentTransform transform;
+    Layout layout;
+    std::array<uint8_t, sizeof(Box) - sizeof(layoutengine::utils::Transform) - sizeof(Layout)> otherFields{};
+};
+
+/* Same math as Transform::computeViewableArea, done on the node resident fields. */
+void computeNodeResidentViewableArea(NodeResidentTransform& trans, const NodeResidentTransform& otherTrans,
+    const Layout::TBLR& otherBorder)
+{
+    const glm::vec2 posScale = trans.pos + trans.scale;
+    const glm::ivec2 newVscale = otherTrans.vScale
+        - glm::ivec2{otherBorder.left + otherBorder.right, otherBorder.top + otherBorder.bot};
+    const glm::ivec2 newVPos = otherTrans.vPos + glm::ivec2{otherBorder.left, otherBorder.top};
+    const glm::vec2 otherVPosScale = newVPos + newVscale;
+
+    trans.vPos.x = std::max(newVPos.x, (int32_t)trans.pos.x);
+    trans.vPos.y = std::max(newVPos.y, (int32_t)trans.pos.y);
+    trans.vScale.x = std::min(otherVPosScale.x, posScale.x) - trans.vPos.x;
+    trans.vScale.y = std::min(otherVPosScale.y, posScale.y) - trans.vPos.y;
+}
+
+/* Hardware cache misses of the calling thread. Only counts if the kernel lets us (see perf_event_paranoid),
+   otherwise isAvailable() is false and the benchmark reports times alone. */
+class CacheMissCounter
+{
+public:
+    CacheMissCounter()
+    {
+        perf_event_attr attr{};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+
+    ~CacheMissCounter()
+    {
+        if (fd_ >= 0) { close(fd_); }
+    }
+
+    /* Cannot be copied or moved */
+    CacheMissCounter(const CacheMissCounter&) = delete;
+    CacheMissCounter(CacheMissCounter&&) = delete;
+    CacheMissCounter& operator=(const CacheMissCounter&) = delete;
+    CacheMissCounter& operator=(CacheMissCounter&&) = delete;
+
+    bool isAvailable() const { return fd_ >= 0; }
+
+    void start()
+    {
+        if (fd_ < 0) { return; }
+        ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+    }
+
+    uint64_t stop()
+    {
+        if (fd_ < 0) { return 0; }
+        ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+        uint64_t count{0};
+        if (read(fd_, &count, sizeof(count)) != sizeof(count)) { return 0; }
+        return count;
+    }
+
+private:
+    int32_t fd_{-1};
+};
+
+/* Viewable areas of a synthetic 50k-node tree (rows of cells under a root). Baseline is the pre-store layout, every
+   node carrying its own transform & being visited through a pointer. Against it goes one sweep over the
+   TransformStore arrays. Cache misses get reported per node next to the times, the same numbers
+   `perf stat -e cache-misses` would attribute to each loop. */
+void benchViewableArea(const Logger& logger)
+{
+    static constexpr int32_t ROWS = 250;
+    static constexpr int32_t CELLS_PER_ROW = 200;
+    static constexpr int32_t ROUNDS = 50;
+
+    using layoutengine::utils::ViewableAreaBatch;
+    NodeResidentBox residentRoot;
+    residentRoot.transform.pos = {0, 0, 1};
+    residentRoot.transform.scale = {1280, 720, 1};
+    residentRoot.transform.vPos = {0, 0};
+    residentRoot.transform.vScale = {1280, 720};
+
+    BoxPtr root = Utils::make<Box>("BenchRoot");
+    root->getTransform().pos = {0, 0, 1};
+    root->getTransform().scale = {1280, 720, 1};
+    root->getTransform().vPos = {0, 0};
+    root->getTransform().vScale = {1280, 720};
+
+    /* Parent of each node sits at the same index, parents always come before their subNodes. Resident nodes are
+       allocated one by one, same as the nodes used to be. */
+    std::vector<std::unique_ptr<NodeResidentBox>> residentNodes;
+    std::vector<NodeResidentBox*> residentParents;
+    std::vector<BoxPtr> nodes;
+    residentNodes.reserve(ROWS * (CELLS_PER_ROW + 1));
+    residentParents.reserve(ROWS * (CELLS_PER_ROW + 1));
+    nodes.reserve(ROWS * (CELLS_PER_ROW + 1));
+    ViewableAreaBatch batch;
+    for (int32_t row = 0; row < ROWS; row++)
+    {
+        const glm::vec3 pos{0, (float)(row * 30), 2};
+        const glm::vec3 scale{1280, 30, 1};
+
+        std::unique_ptr<NodeResidentBox> residentRow = std::make_unique<NodeResidentBox>();
+        residentRow->transform.pos = pos;
+        residentRow->transform.scale = scale;
+        residentNodes.emplace_back(std::move(residentRow));
+        residentParents.emplace_back(&residentRoot);
+
+        BoxPtr rowBox = Utils::make<Box>("BenchRow");
+        rowBox->getTransform().pos = pos;
+        rowBox->getTransform().scale = scale;
+        batch.add(1, rowBox->getTransform().slot, root->getTransform().slot, false);
+        nodes.emplace_back(rowBox);
+    }
+    for (int32_t row = 0; row < ROWS; row++)
+    {
+        NodeResidentBox* residentRow = residentNodes[row].get();
+        AbstractNode* rowBox = nodes[row].get();
+        for (int32_t col = 0; col < CELLS_PER_ROW; col++)
+        {
+            const glm::vec3 pos{(float)(col * 8), (float)(row * 30 + 1), 3};
+            const glm::vec3 scale{7, 28, 1};
+
+            std::unique_ptr<NodeResidentBox> residentCell = std::make_unique<NodeResidentBox>();
+            residentCell->transform.pos = pos;
+            residentCell->transform.scale = scale;
+            residentNodes.emplace_back(std::move(residentCell));
+            residentParents.emplace_back(residentRow);
+
+            BoxPtr cell = Utils::make<Box>("BenchCell");
+            cell->getTransform().pos = pos;
+            cell->getTransform().scale = scale;
+            batch.add(2, cell->getTransform().slot, rowBox->getTransform().slot, false);
+            nodes.emplace_back(cell);
+        }
+    }
+
+    CacheMissCounter missCounter;
+    const double nodeCount = residentNodes.size();
+
+    missCounter.start();
+    Clock::time_point start = Clock::now();
+    for (int32_t round = 0; round < ROUNDS; round++)
+    {
+        for (size_t i = 0; i < residentNodes.size(); i++)
+        {
+            computeNodeResidentViewableArea(residentNodes[i]->transform, residentParents[i]->transform,
+                residentParents[i]->layout.border);
+        }
+    }
+    const double residentMs = elapsedNs(start) / ROUNDS / 1e6;
+    const double residentMisses = missCounter.stop() / (ROUNDS * nodeCount);
+
+    missCounter.start();
+    start = Clock::now();
+    for (int32_t round = 0; round < ROUNDS; round++)
+    {
+        batch.compute();
+    }
+    const double batchMs = elapsedNs(start) / ROUNDS / 1e6;
+    const double batchMisses = missCounter.stop() / (ROUNDS * nodeCount);
+
+    if (!missCounter.isAvailable())
+    {
+        logger.infoLn("Viewable area of %u nodes: node resident %.3f ms, store sweep %.3f ms (cache misses not "
+            "available, try perf stat -e cache-misses)", (uint32_t)nodeCount, residentMs, batchMs);
+        return;
+    }
+
+    logger.infoLn("Viewable area of %u nodes: node resident %.3f ms (%.3f cache misses/node), store sweep %.3f ms "
+        "(%.3f cache misses/node)", (uint32_t)nodeCount, residentMs, residentMisses, batchMs, batchMisses);
+}
+} // namespace
+
+int main()
+{
+    /*
+        Not really an example but a small benchmark of the node plumbing. Click the button to run it, results get
+        printed to the console:
+        - churn of nodes created & destroyed in batches, going through the NodePool (Utils::make) versus plain
+          std::make_shared
+        - resolving a NodeHandle versus locking a std::weak_ptr
+        - dispatching an event through a node's event manager, to one channel and to all of them
+        - dispatching mouse moves over a grid of boxes, driven through the real GLFW cursor callback
+        - computing viewable areas of a 50k-node tree with transforms living in each node (as before the transform
+          store) versus sweeping the store, with cache misses per node when perf counters are readable
+    */
+    Application& app = Application::get();
+    if (!app.init()) { return 1; }
+
+    Logger mainLogger("mainLog");
+
+    WindowFramePtr& window = app.createFrame("MainWindow", 1280, 720);
+
+    BoxPtr rootBox = window->getRoot();
+    rootBox->setColor(Utils::hexToVec4("#4aabebff"));
+    rootBox->getLayout()
+        .setType(Layout::Type::VERTICAL)
+        .setPadding({10});
+
+    ButtonPtr runBtn = Utils::make<Button>("RunBench");
+    runBtn->getLayout().setScale({200, 40});
+    rootBox->append(runBtn);
+
+    /* Grid of boxes for the mouse to move over. */
+    static constexpr int32_t GRID_ROWS = 20;
+    static constexpr int32_t GRID_COLS = 40;
+    for (int32_t row = 0; row < GRID_ROWS; row++)
+    {
+        BoxPtr rowBox = Utils::make<Box>("Row" + std::to_string(row));
+        rowBox->setColor(Utils::randomRGB());
+        rowBox->getLayout()
+            .setType(Layout::Type::HORIZONTAL)
+            .setScaleType({Layout::ScaleType::REL, Layout::ScaleType::PX})
+            .setScale({1.0f, 30});
+        for (int32_t col = 0; col < GRID_COLS; col++)
+        {
+            BoxPtr cell = Utils::make<Box>("Cell");
+            cell->setColor(Utils::randomRGB());
+            cell->getLayout()
+                .setScaleType(Layout::ScaleType::PX)
+                .setScale({28, 28})
+                .setMargin({1});
+            rowBox->append(cell);
+        }
+        rootBox->append(rowBox);
+    }
+
+    runBtn->getEvents().listen<events::LMBRelease>(
+        [mainLogger, &window, ref = Utils::ref<Button>(runBtn)](const auto&)
+        {
+            static constexpr int32_t CHURN_ROUNDS = 1000;
+            static constexpr int32_t CHURN_ROWS = 100;
+            const double pooledNs = benchChurn([]() { return Utils::make<Button>("Item"); },
+                CHURN_ROUNDS, CHURN_ROWS);
+            const double sharedNs = benchChurn([]() { return std::make_shared<Button>("Item"); },
+                CHURN_ROUNDS, CHURN_ROWS);
+            mainLogger.infoLn("Node churn: pooled %.1f ns/node, make_shared %.1f ns/node", pooledNs, sharedNs);
+
+            static constexpr int32_t RESOLVE_COUNT = 1'000'000;
+            ButtonPtr btn = ref.lock();
+            const NodeHandle handle = btn->getHandle();
+            const std::weak_ptr<Button> weak = btn;
+            NodeRegistry& registry = NodeRegistry::get();
+            uint32_t hits{0};
+            Clock::time_point start = Clock::now();
+            for (int32_t i = 0; i < RESOLVE_COUNT; i++)
+            {
+                hits += registry.resolve(handle) != nullptr;
+            }
+            const double handleNs = elapsedNs(start) / RESOLVE_COUNT;
+            start = Clock::now();
+            for (int32_t i = 0; i < RESOLVE_COUNT; i++)
+            {
+                hits += weak.lock() != nullptr;
+            }
+            const double weakNs = elapsedNs(start) / RESOLVE_COUNT;
+            mainLogger.infoLn("Resolve (%u hits): handle %.2f ns, weak_ptr lock %.2f ns", hits, handleNs, weakNs);
+
+            static constexpr int32_t DISPATCH_COUNT = 1'000'000;
+            events::NodeEventManager eventManager;
+            int32_t received{0};
+            const auto onBenchEvent = [&received](const auto& evt) { received += evt.value; };
+            eventManager.listen<BenchEvent, events::InputChannel>(onBenchEvent);
+            eventManager.listen<BenchEvent>(onBenchEvent);
+            BenchEvent benchEvt;
+            start = Clock::now();
+            for (int32_t i = 0; i < DISPATCH_COUNT; i++)
+            {
+                eventManager.notifyEvent<BenchEvent>(benchEvt);
+            }
+            const double singleNs = elapsedNs(start) / DISPATCH_COUNT;
+            start = Clock::now();
+            for (int32_t i = 0; i < DISPATCH_COUNT; i++)
+            {
+                eventManager.notifyAllChannels<BenchEvent>(benchEvt);
+            }
+            const double allNs = elapsedNs(start) / DISPATCH_COUNT;
+            mainLogger.infoLn("Event dispatch (%d received): one channel %.2f ns, all channels %.2f ns",
+                received, singleNs, allNs);
+
+            /* Hijack the cursor callback the frame installed so moves go through the exact same path as real ones. */
+            const Window& win = window->getWindow();
+            GLFWwindow* windowHandle = win.getHandle();
+            const GLFWcursorposfun cursorCallback = glfwSetCursorPosCallback(windowHandle, nullptr);
+            glfwSetCursorPosCallback(windowHandle, cursorCallback);
+
+            static constexpr int32_t MOVE_COUNT = 200'000;
+            const int32_t width = win.getWidth();
+            const int32_t height = win.getHeight();
+            start = Clock::now();
+            for (int32_t i = 0; i < MOVE_COUNT; i++)
+            {
+                cursorCallback(windowHandle, (i * 7) % width, (i * 3) % height);
+            }
+            mainLogger.infoLn("Mouse move dispatch: %.1f ns/move", elapsedNs(start) / MOVE_COUNT);
+
+            benchViewableArea(mainLogger);
+        });
+
+    app.setPollMode(Application::PollMode::ON_EVENT);
+    app.setVSync(true);
+
+    /* Blocks from here on */
+    app.run();
+
+    return 0;
+}
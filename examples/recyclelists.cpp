@@ -58,6 +58,14 @@ int main()
         rl->addItem(Utils::randomRGB());
     }
 
+    /* Alternatively the items can come from a data source, the list only fetches the ones visible. Useful when
+       there are millions of them. (uncomment bellow) */
+    // rl->setItemProvider(20'000'000, [](const int32_t idx, node::utils::ListItem& item)
+    // {
+    //     item.color = idx % 2 ? Utils::COLOR_WHITE : Utils::hexToVec4("#dddddd");
+    //     item.text = "Row " + std::to_string(idx);
+    // });
+
     /* Do custom logic when the user clicks (technically releases click) on an item. */
     rl->getEvents().listen<nodeevent::LMBItemRelease>(
         [mainLogger, ref = Utils::ref<RecycleList>(rl)](const auto& evt)
@@ -103,6 +103,22 @@ int main()
     tv->addRootItem(root);
     // tv->addRootItem(root2);
 
+    /* Items can also fetch their sub items only when opened, handy for big hierarchies living somewhere else. */
+    // root2->hasLazyChildren = true;
+    // tv->setChildrenProvider([](const TreeItemPtr& item)
+    //     {
+    //         TreeItemPtrVec children;
+    //         for (int i = 0; i < 5; i++)
+    //         {
+    //             TreeItemPtr child = Utils::make<TreeItem>();
+    //             child->color = Utils::randomRGB();
+    //             child->text = item->text + "_" + std::to_string(i);
+    //             child->hasLazyChildren = true;
+    //             children.emplace_back(child);
+    //         }
+    //         return children;
+    //     }, true);
+
     tv->getEvents().listen<events::LMBTreeItemRelease>(
         [ref = Utils::ref<TreeView>(tv), mainLogger](const auto& evt)
         {
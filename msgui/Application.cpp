@@ -3,6 +3,8 @@
 #include <GLFW/glfw3.h>
 
 #include "msgui/loaders/BELoadingQueue.hpp"
+#include "msgui/loaders/FontLoader.hpp"
+#include "msgui/loaders/ShaderLoader.hpp"
 #include "msgui/Window.hpp"
 #include "msgui/node/FrameState.hpp"
 #include "msgui/node/WindowFrame.hpp"
@@ -80,7 +82,8 @@ void Application::run()
                 if (frame->isPrimary() && delta > 1.0f)
                 {
                     FPS_ = frameCount / delta;
-                    frame->window_.setTitle(std::to_string(FPS_));
+                    frame->window_.setTitle(std::to_string(FPS_) + " | draw calls: "
+                        + std::to_string(frame->getRenderStats().drawCalls));
 
                     frameCount = 0;
                     previousTime = currentTime;
@@ -125,6 +128,21 @@ void Application::setVSync(const bool vsyncValue)
     }
 }
 
+void Application::setShaderCacheDir(const std::string& dirPath)
+{
+    loaders::ShaderLoader::setBinaryCacheDir(dirPath);
+}
+
+void Application::setGlyphCacheBudget(const int64_t budget)
+{
+    loaders::FontLoader::get().setGlyphCacheBudget(budget);
+}
+
+void Application::setSdfFonts(const bool value)
+{
+    loaders::FontLoader::get().setSdfMode(value);
+}
+
 WindowFrameWPtr Application::getFrameBy(const std::function<bool(const WindowFramePtr&)>& pred)
 {
     const auto it = std::find_if(frames_.begin(), frames_.end(), pred);
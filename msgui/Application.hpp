@@ -57,6 +57,31 @@ public:
     */
     void setVSync(const bool vsyncValue);
 
+    /**
+        Sets the directory where linked shader programs get cached between launches.
+        Note: Needs to be called before creating any frames in order to speed up their creation.
+
+        @param dirPath Cache directory path. Empty to disable caching (default)
+    */
+    void setShaderCacheDir(const std::string& dirPath);
+
+    /**
+        Set how much memory glyphs rasterized on demand (outside of the eagerly loaded range) can take up in the
+        glyph atlas. Least recently used glyphs get evicted past it.
+
+        @param budget Budget in bytes
+    */
+    void setGlyphCacheBudget(const int64_t budget);
+
+    /**
+        Use signed distance field fonts. Glyphs get rasterized once per face and scaled to any font size, so changing
+        text size doesn't need a new FreeType pass.
+        Note: Needs to be called before creating any frames in order to apply to their default fonts.
+
+        @param value True for SDF fonts, False for bitmap fonts (default)
+    */
+    void setSdfFonts(const bool value);
+
     /**
         Find and return window frame satisfying a predicate.
 
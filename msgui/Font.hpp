@@ -1,8 +1,10 @@
 #pragma once
 
 #include <stdint.h>
+#include <list>
 #include <string>
 #include <memory>
+#include <unordered_map>
 
 #include <glm/glm.hpp>
 
@@ -12,8 +14,22 @@ static constexpr int32_t MAX_CODEPOINTS    {256};
 static constexpr int32_t DEFAULT_FONT_SIZE {16};
 static constexpr int32_t MIN_FONT_SIZE     {10};
 static constexpr int32_t MAX_FONT_SIZE     {88};
+static constexpr int32_t SDF_REFERENCE_SIZE{48};
+static constexpr int32_t SDF_SPREAD        {8};
 static const std::string DEFAULT_FONT_PATH {"/home/hekapoo/Documents/probe/newgui/assets/fonts/Arial.ttf"};
 
+struct Font;
+
+/* Entry of the lazily rasterized glyphs LRU list. Most recently used glyphs are at the front. */
+struct LazyGlyphRef
+{
+    Font* font{nullptr};
+    uint32_t codePoint{0};
+    int64_t bytes{0};
+    uint64_t lastUsedPass{0};
+};
+using LazyGlyphList = std::list<LazyGlyphRef>;
+
 struct Font
 {
     struct CodePointData
@@ -22,12 +38,28 @@ struct Font
         int64_t hAdvance;
         glm::ivec2 size;
         glm::ivec2 bearing;
+        uint32_t atlasSlot;  /* Slot inside the glyph atlas, zero if glyph has no bitmap */
+        glm::ivec4 uvRect;   /* Texel rect (x, y, w, h) of the bitmap inside the glyph atlas */
     };
 
+    struct LazyCodePointData
+    {
+        CodePointData data;
+        LazyGlyphList::iterator lruIt;
+    };
+
+    /* Codepoints below MAX_CODEPOINTS are loaded together with the font and never evicted. Everything else gets
+       rasterized on first use by the FontLoader and may be evicted when the glyph cache budget is exceeded. */
     CodePointData codePointData[MAX_CODEPOINTS];
-    uint32_t texId{0};
+    std::unordered_map<uint32_t, LazyCodePointData> lazyCodePointData;
+    bool isLoaded{false};
     int32_t fontSize{16};
     std::string fontPath;
+
+    /* SDF fonts of any size don't hold glyphs themselves, they scale the ones of the reference size font. */
+    bool isSdf{false};
+    float scale{1.0f};
+    std::shared_ptr<Font> glyphSource{nullptr};
 };
 using FontPtr = std::shared_ptr<Font>;
 } // namespace msgui
\ No newline at end of file
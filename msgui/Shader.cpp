@@ -1,15 +1,44 @@
 #include "Shader.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <string>
+
 #include <glm/gtc/type_ptr.hpp>
 
 namespace msgui
 {
 uint32_t Shader::boundShaderId_ = 0;
 
-Shader::Shader(const uint32_t shaderId, const std::string& shaderName)
+namespace
+{
+/* Size of one element of a uniform, as uploaded by the setters. */
+int32_t uniformElementSize(const uint32_t type)
+{
+    switch (type)
+    {
+        case GL_FLOAT_VEC2:
+        case GL_INT_VEC2:
+            return sizeof(glm::vec2);
+        case GL_FLOAT_VEC3:
+        case GL_INT_VEC3:
+            return sizeof(glm::vec3);
+        case GL_FLOAT_VEC4:
+        case GL_INT_VEC4:
+            return sizeof(glm::vec4);
+        case GL_FLOAT_MAT4:
+            return sizeof(glm::mat4);
+        /* Floats, ints, bools and samplers */
+        default:
+            return sizeof(int32_t);
+    }
+}
+} // namespace
+
+Shader::Shader(const uint32_t shaderId, UniformTable&& uniforms, const std::string& shaderName)
     : shaderId_(shaderId)
     , log_("Shader(" + shaderName + " = " + std::to_string(shaderId_) + ")")
+    , uniforms_(std::move(uniforms))
 {}
 
 Shader& Shader::operator=(Shader&& other)
@@ -17,6 +46,9 @@ Shader& Shader::operator=(Shader&& other)
     /* Used for hot reloading code */
     shaderId_ = other.shaderId_;
     other.shaderId_ = 0;
+
+    /* Locations and uploaded values belong to the old program. */
+    uniforms_ = std::move(other.uniforms_);
     return *this;
 }
 
@@ -39,139 +71,253 @@ void Shader::unbind() const
 
 void Shader::setTexture1D(const std::string& name, const TextureUnitId texUnit, const uint32_t texId) const
 {
-    setTexture(name, texUnit, texId, GL_TEXTURE_1D);
+    setTexture1D(getUniformId(name), texUnit, texId);
+}
+
+void Shader::setTexture1D(const UniformId id, const TextureUnitId texUnit, const uint32_t texId) const
+{
+    setTexture(id, texUnit, texId, GL_TEXTURE_1D);
 }
 
 void Shader::setTexture2D(const std::string& name, const TextureUnitId texUnit, const uint32_t texId) const
 {
-    setTexture(name, texUnit, texId, GL_TEXTURE_2D);
+    setTexture2D(getUniformId(name), texUnit, texId);
+}
+
+void Shader::setTexture2D(const UniformId id, const TextureUnitId texUnit, const uint32_t texId) const
+{
+    setTexture(id, texUnit, texId, GL_TEXTURE_2D);
 }
 
 void Shader::setTexture3D(const std::string& name, const TextureUnitId texUnit, const uint32_t texId) const
 {
-    setTexture(name, texUnit, texId, GL_TEXTURE_3D);
+    setTexture3D(getUniformId(name), texUnit, texId);
+}
+
+void Shader::setTexture3D(const UniformId id, const TextureUnitId texUnit, const uint32_t texId) const
+{
+    setTexture(id, texUnit, texId, GL_TEXTURE_3D);
 }
 
 void Shader::setTexture1DArray(const std::string& name, const TextureUnitId texUnit,
     const uint32_t texId) const
 {
-    setTexture(name, texUnit, texId, GL_TEXTURE_1D_ARRAY);
+    setTexture1DArray(getUniformId(name), texUnit, texId);
+}
+
+void Shader::setTexture1DArray(const UniformId id, const TextureUnitId texUnit,
+    const uint32_t texId) const
+{
+    setTexture(id, texUnit, texId, GL_TEXTURE_1D_ARRAY);
 }
 
 void Shader::setTexture2DArray(const std::string& name, const TextureUnitId texUnit,
     const uint32_t texId) const
 {
-    setTexture(name, texUnit, texId, GL_TEXTURE_2D_ARRAY);
+    setTexture2DArray(getUniformId(name), texUnit, texId);
+}
+
+void Shader::setTexture2DArray(const UniformId id, const TextureUnitId texUnit,
+    const uint32_t texId) const
+{
+    setTexture(id, texUnit, texId, GL_TEXTURE_2D_ARRAY);
+}
+
+void Shader::setTextureBuffer(const std::string& name, const TextureUnitId texUnit,
+    const uint32_t texId) const
+{
+    setTextureBuffer(getUniformId(name), texUnit, texId);
+}
+
+void Shader::setTextureBuffer(const UniformId id, const TextureUnitId texUnit,
+    const uint32_t texId) const
+{
+    setTexture(id, texUnit, texId, GL_TEXTURE_BUFFER);
 }
 
 void Shader::setInt(const std::string& name, const int32_t value) const
+{
+    setInt(getUniformId(name), value);
+}
+
+void Shader::setInt(const UniformId id, const int32_t value) const
 {
     bind();
 
-    int32_t loc = glGetUniformLocation(shaderId_, name.c_str());
-    if (loc == -1)
+    UniformData* uniform = findUniform(id);
+    if (!uniform)
     {
-        return handleNotFoundLocation(name);
+        return handleNotFoundLocation(id);
     }
 
-    glUniform1i(loc, value);
+    if (!updateShadow(*uniform, 0, 1, &value)) { return; }
+    glUniform1i(uniform->location, value);
 }
 
 void Shader::setIntv(const std::string& name, const std::vector<int32_t>& values) const
+{
+    setIntv(getUniformId(name), values);
+}
+
+void Shader::setIntv(const UniformId id, const std::vector<int32_t>& values) const
+{
+    bind();
+
+    UniformData* uniform = findUniform(id);
+    if (!uniform)
+    {
+        return handleNotFoundLocation(id);
+    }
+
+    if (!updateShadow(*uniform, 0, values.size(), values.data())) { return; }
+    glUniform1iv(uniform->location, values.size(), values.data());
+}
+
+void Shader::setFloat(const std::string& name, const float value) const
+{
+    setFloat(getUniformId(name), value);
+}
+
+void Shader::setFloat(const UniformId id, const float value) const
 {
     bind();
 
-    int32_t loc = glGetUniformLocation(shaderId_, name.c_str());
-    if (loc == -1)
+    UniformData* uniform = findUniform(id);
+    if (!uniform)
     {
-        return handleNotFoundLocation(name);
+        return handleNotFoundLocation(id);
     }
-    glUniform1iv(loc, values.size(), values.data());
+    if (!updateShadow(*uniform, 0, 1, &value)) { return; }
+    glUniform1f(uniform->location, value);
 }
 
 void Shader::setVec2i(const std::string& name, const glm::ivec2& value) const
+{
+    setVec2i(getUniformId(name), value);
+}
+
+void Shader::setVec2i(const UniformId id, const glm::ivec2& value) const
 {
     bind();
 
-    int32_t loc = glGetUniformLocation(shaderId_, name.c_str());
-    if (loc == -1)
+    UniformData* uniform = findUniform(id);
+    if (!uniform)
     {
-        return handleNotFoundLocation(name);
+        return handleNotFoundLocation(id);
     }
-    glUniform2i(loc, value.x, value.y);
+    if (!updateShadow(*uniform, 0, 1, &value)) { return; }
+    glUniform2i(uniform->location, value.x, value.y);
 }
 
 void Shader::setVec2f(const std::string& name, const glm::vec2& value) const
+{
+    setVec2f(getUniformId(name), value);
+}
+
+void Shader::setVec2f(const UniformId id, const glm::vec2& value) const
 {
     bind();
 
-    int32_t loc = glGetUniformLocation(shaderId_, name.c_str());
-    if (loc == -1)
+    UniformData* uniform = findUniform(id);
+    if (!uniform)
     {
-        return handleNotFoundLocation(name);
+        return handleNotFoundLocation(id);
     }
-    glUniform2f(loc, value.x, value.y);
+    if (!updateShadow(*uniform, 0, 1, &value)) { return; }
+    glUniform2f(uniform->location, value.x, value.y);
 }
 
 void Shader::setVec3f(const std::string& name, const glm::vec3& value) const
+{
+    setVec3f(getUniformId(name), value);
+}
+
+void Shader::setVec3f(const UniformId id, const glm::vec3& value) const
 {
     bind();
 
-    int32_t loc = glGetUniformLocation(shaderId_, name.c_str());
-    if (loc == -1)
+    UniformData* uniform = findUniform(id);
+    if (!uniform)
     {
-        return handleNotFoundLocation(name);
+        return handleNotFoundLocation(id);
     }
-    glUniform3f(loc, value.x, value.y, value.z);
+    if (!updateShadow(*uniform, 0, 1, &value)) { return; }
+    glUniform3f(uniform->location, value.x, value.y, value.z);
 }
 
 void Shader::setVec4f(const std::string& name, const glm::vec4& value) const
+{
+    setVec4f(getUniformId(name), value);
+}
+
+void Shader::setVec4f(const UniformId id, const glm::vec4& value) const
 {
     bind();
 
-    int32_t loc = glGetUniformLocation(shaderId_, name.c_str());
-    if (loc == -1)
+    UniformData* uniform = findUniform(id);
+    if (!uniform)
     {
-        return handleNotFoundLocation(name);
+        return handleNotFoundLocation(id);
     }
-    glUniform4f(loc, value.x, value.y, value.z, value.w);
+    if (!updateShadow(*uniform, 0, 1, &value)) { return; }
+    glUniform4f(uniform->location, value.x, value.y, value.z, value.w);
 }
 
 void Shader::setMat4f(const std::string& name, const glm::mat4& value) const
+{
+    setMat4f(getUniformId(name), value);
+}
+
+void Shader::setMat4f(const UniformId id, const glm::mat4& value) const
 {
     bind();
 
-    int32_t loc = glGetUniformLocation(shaderId_, name.c_str());
-    if (loc == -1)
+    UniformData* uniform = findUniform(id);
+    if (!uniform)
     {
-        return handleNotFoundLocation(name);
+        return handleNotFoundLocation(id);
     }
+    if (!updateShadow(*uniform, 0, 1, &value)) { return; }
+
     constexpr uint32_t transposeMatrix = GL_FALSE;
-    glUniformMatrix4fv(loc, 1, transposeMatrix, glm::value_ptr(value));
+    glUniformMatrix4fv(uniform->location, 1, transposeMatrix, glm::value_ptr(value));
 }
 
 void Shader::setMat4fv(const std::string& name, const std::vector<glm::mat4>& values) const
+{
+    setMat4fv(getUniformId(name), values);
+}
+
+void Shader::setMat4fv(const UniformId id, const std::vector<glm::mat4>& values) const
 {
     bind();
 
-    int32_t loc = glGetUniformLocation(shaderId_, name.c_str());
-    if (loc == -1)
+    UniformData* uniform = findUniform(id);
+    if (!uniform)
     {
-        return handleNotFoundLocation(name);
+        return handleNotFoundLocation(id);
     }
+    if (!updateShadow(*uniform, 0, values.size(), values.data())) { return; }
+
     constexpr uint32_t transposeMatrix = GL_FALSE;
-    glUniformMatrix4fv(loc, values.size(), transposeMatrix, glm::value_ptr(values[0]));
+    glUniformMatrix4fv(uniform->location, values.size(), transposeMatrix, glm::value_ptr(values[0]));
 }
 
 void Shader::setPartialMat4fv(const std::string& name, const int32_t startIdx,  const int32_t endIdx,
     const std::vector<glm::mat4>& values) const
+{
+    setPartialMat4fv(getUniformId(name), startIdx, endIdx, values);
+}
+
+void Shader::setPartialMat4fv(const UniformId id, const int32_t startIdx,  const int32_t endIdx,
+    const std::vector<glm::mat4>& values) const
 {
     bind();
 
-    int32_t loc = glGetUniformLocation(shaderId_, name.c_str());
-    if (loc == -1)
+    UniformData* uniform = findUniform(id);
+    if (!uniform)
     {
-        return handleNotFoundLocation(name);
+        return handleNotFoundLocation(id);
     }
 
     if (endIdx - startIdx <= 0)
@@ -179,9 +325,11 @@ void Shader::setPartialMat4fv(const std::string& name, const int32_t startIdx,
         log_.warnLn("Trying to set mat4v but the indices difference is zero or less than zero!");
         return;
     }
+    /* The slice gets uploaded to the start of the uniform array. */
+    if (!updateShadow(*uniform, 0, endIdx - startIdx, &values[startIdx])) { return; }
 
     constexpr uint32_t transposeMatrix = GL_FALSE;
-    glUniformMatrix4fv(loc, endIdx - startIdx, transposeMatrix, glm::value_ptr(values[startIdx]));
+    glUniformMatrix4fv(uniform->location, endIdx - startIdx, transposeMatrix, glm::value_ptr(values[startIdx]));
 }
 
 uint32_t Shader::getShaderId() const
@@ -189,7 +337,63 @@ uint32_t Shader::getShaderId() const
     return shaderId_;
 }
 
-void Shader::setTexture(const std::string& name, const TextureUnitId texUnit, const uint32_t texId,
+Shader::UniformTable Shader::resolveUniforms(const uint32_t shaderId)
+{
+    UniformTable uniforms;
+    if (!shaderId) { return uniforms; }
+
+    int32_t activeUniforms = 0;
+    int32_t maxNameLength = 0;
+    glGetProgramiv(shaderId, GL_ACTIVE_UNIFORMS, &activeUniforms);
+    glGetProgramiv(shaderId, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+    std::string name(maxNameLength, '\0');
+    for (int32_t idx = 0; idx < activeUniforms; idx++)
+    {
+        int32_t nameLength = 0;
+        int32_t arraySize = 0;
+        uint32_t type = 0;
+        glGetActiveUniform(shaderId, idx, maxNameLength, &nameLength, &arraySize, &type, name.data());
+
+        /* Arrays are reported as "name[0]" but are set using just "name". */
+        std::string uniformName = name.substr(0, nameLength);
+        if (const size_t bracketPos = uniformName.find('['); bracketPos != std::string::npos)
+        {
+            uniformName.resize(bracketPos);
+        }
+
+        /* Uniforms coming from uniform blocks have no location, they can't be set from here anyway. */
+        const int32_t location = glGetUniformLocation(shaderId, uniformName.c_str());
+        if (location == -1) { continue; }
+
+        const UniformId id = getUniformId(uniformName);
+        if (id >= (UniformId)uniforms.size()) { uniforms.resize(id + 1); }
+
+        UniformData& uniform = uniforms[id];
+        uniform.location = location;
+        uniform.elementSize = uniformElementSize(type);
+        uniform.shadow.assign(uniform.elementSize * arraySize, 0);
+        uniform.isElementShadowed.assign(arraySize, false);
+    }
+    return uniforms;
+}
+
+UniformId Shader::getUniformId(const std::string& name)
+{
+    UniformRegistry& registry = uniformRegistry();
+    std::lock_guard lock(registry.mtx);
+    auto [it, isNew] = registry.ids.try_emplace(name, (UniformId)registry.names.size());
+    if (isNew) { registry.names.emplace_back(name); }
+    return it->second;
+}
+
+Shader::UniformRegistry& Shader::uniformRegistry()
+{
+    static UniformRegistry registry;
+    return registry;
+}
+
+void Shader::setTexture(const UniformId id, const TextureUnitId texUnit, const uint32_t texId,
     const TextureTargetType type) const
 {
     bind();
@@ -204,7 +408,7 @@ void Shader::setTexture(const std::string& name, const TextureUnitId texUnit, co
     }
 
     /* Shader needs texture unit location in range from [0..maxUnits], not from [GL_TEXTURE0..maxGL_TEXTURE] */
-    setInt(name, texUnit - GL_TEXTURE0);
+    setInt(id, texUnit - GL_TEXTURE0);
 
     /* Active unit needs to be indeed [GL_TEXTURE0..maxGL_TEXTURE] */
     glActiveTexture(texUnit);
@@ -212,9 +416,41 @@ void Shader::setTexture(const std::string& name, const TextureUnitId texUnit, co
     glBindTexture(type, texId);
 }
 
-inline void Shader::handleNotFoundLocation(const std::string& name) const
+inline void Shader::handleNotFoundLocation(const UniformId id) const
 {
-    log_.errorLn("Uniform \"%s\" not found", name.c_str());
+    UniformRegistry& registry = uniformRegistry();
+    std::lock_guard lock(registry.mtx);
+    const bool isKnownId = id >= 0 && id < (UniformId)registry.names.size();
+    log_.errorLn("Uniform \"%s\" not found", isKnownId ? registry.names[id].c_str() : "<invalid id>");
     exit(1);
 }
-} // namespace msgui
\ No newline at end of file
+
+Shader::UniformData* Shader::findUniform(const UniformId id) const
+{
+    if (id < 0 || id >= (UniformId)uniforms_.size() || uniforms_[id].location == -1) { return nullptr; }
+    return &uniforms_[id];
+}
+
+bool Shader::updateShadow(UniformData& uniform, const int32_t firstElement, const int32_t elementCount,
+    const void* values) const
+{
+    /* Writes going past the array as the program knows it are left for GL to complain about. */
+    const int32_t shadowedElements = uniform.isElementShadowed.size();
+    if (firstElement < 0 || firstElement + elementCount > shadowedElements) { return true; }
+
+    /* Values already in the program don't need to be uploaded again. */
+    uint8_t* shadow = uniform.shadow.data() + firstElement * uniform.elementSize;
+    const size_t size = elementCount * uniform.elementSize;
+    const auto first = uniform.isElementShadowed.begin() + firstElement;
+    const auto last = first + elementCount;
+    if (std::all_of(first, last, [](const bool isShadowed) { return isShadowed; })
+        && !std::memcmp(shadow, values, size))
+    {
+        return false;
+    }
+
+    std::memcpy(shadow, values, size);
+    std::fill(first, last, true);
+    return true;
+}
+} // namespace msgui
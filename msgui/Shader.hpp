@@ -1,6 +1,8 @@
 #pragma once
 
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <GL/glew.h>
@@ -13,17 +15,35 @@ namespace msgui
 using TextureUnitId = uint32_t;
 using TextureTargetType = uint32_t;
 
+/* Handle of a uniform name. Ids are shared by all shaders, so a handle can be resolved once and used with any
+   shader having a uniform of that name. */
+using UniformId = int32_t;
+static constexpr UniformId NO_UNIFORM{-1};
+
 /* Class holding data about a shader */
 class Shader
 {
 public:
+    /* Active uniform of a linked program plus the last values uploaded to each of its elements. */
+    struct UniformData
+    {
+        int32_t location{-1};
+        int32_t elementSize{0};
+        std::vector<uint8_t> shadow;
+        std::vector<bool> isElementShadowed;
+    };
+
+    /* Uniforms of a program, indexed by UniformId. Names the program doesn't use have a location of -1. */
+    using UniformTable = std::vector<UniformData>;
+
     /**
         Create a shader from given data.
 
         @param shaderId Id of the shader
+        @param uniforms Uniform table of the program, see resolveUniforms
         @param shaderName Name of the shader
      */
-    explicit Shader(const uint32_t shaderId, const std::string& shaderName);
+    explicit Shader(const uint32_t shaderId, UniformTable&& uniforms, const std::string& shaderName);
     ~Shader();
     Shader& operator=(Shader&& other);
 
@@ -37,6 +57,26 @@ public:
     */
     void unbind() const;
 
+    /**
+        Build the uniform table of a program. Meant to be called right after linking.
+        Note: Needs to be called from the GL thread.
+
+        @param shaderId Id of the linked program
+
+        @return Uniform table of the program
+    */
+    static UniformTable resolveUniforms(const uint32_t shaderId);
+
+    /**
+        Get the handle of a uniform name, creating it if needed. Setters taking a name do this on every call, hot
+        paths shall get the handle once and use the setters taking it instead.
+
+        @param name Name of the uniform. Arrays are named without the "[0]" suffix
+
+        @return Handle of the name
+    */
+    static UniformId getUniformId(const std::string& name);
+
     /**
         Set texture 1D uniform inside the shader.
 
@@ -45,6 +85,7 @@ public:
         @param texId Id of the texture
     */
     void setTexture1D(const std::string& name, const TextureUnitId texUnit, const uint32_t texId) const;
+    void setTexture1D(const UniformId id, const TextureUnitId texUnit, const uint32_t texId) const;
 
     /**
         Set texture 2D uniform inside the shader.
@@ -54,6 +95,7 @@ public:
         @param texId Id of the texture
     */
     void setTexture2D(const std::string& name, const TextureUnitId texUnit, const uint32_t texId) const;
+    void setTexture2D(const UniformId id, const TextureUnitId texUnit, const uint32_t texId) const;
 
     /**
         Set texture 3D uniform inside the shader.
@@ -63,6 +105,7 @@ public:
         @param texId Id of the texture
     */
     void setTexture3D(const std::string& name, const TextureUnitId texUnit, const uint32_t texId) const;
+    void setTexture3D(const UniformId id, const TextureUnitId texUnit, const uint32_t texId) const;
 
     /**
         Set texture array 1D uniform inside the shader.
@@ -72,6 +115,7 @@ public:
         @param texId Id of the texture
     */
     void setTexture1DArray(const std::string& name, const TextureUnitId texUnit, const uint32_t texId) const;
+    void setTexture1DArray(const UniformId id, const TextureUnitId texUnit, const uint32_t texId) const;
 
     /**
         Set texture array 2D uniform inside the shader.
@@ -81,6 +125,17 @@ public:
         @param texId Id of the texture
     */
     void setTexture2DArray(const std::string& name, const TextureUnitId texUnit, const uint32_t texId) const;
+    void setTexture2DArray(const UniformId id, const TextureUnitId texUnit, const uint32_t texId) const;
+
+    /**
+        Set texture buffer uniform inside the shader.
+
+        @param name Name of the folder
+        @param texUnit Texture unit to bind texture to
+        @param texId Id of the texture
+    */
+    void setTextureBuffer(const std::string& name, const TextureUnitId texUnit, const uint32_t texId) const;
+    void setTextureBuffer(const UniformId id, const TextureUnitId texUnit, const uint32_t texId) const;
 
     /**
         Set integer uniform inside the shader.
@@ -89,6 +144,7 @@ public:
         @param value Value to be set
     */
     void setInt(const std::string& name, const int32_t value) const;
+    void setInt(const UniformId id, const int32_t value) const;
 
     /**
         Set vector of integers uniform inside the shader.
@@ -97,6 +153,16 @@ public:
         @param values Vector Values to be set
     */
     void setIntv(const std::string& name, const std::vector<int32_t>& values) const;
+    void setIntv(const UniformId id, const std::vector<int32_t>& values) const;
+
+    /**
+        Set float uniform inside the shader.
+
+        @param name Name of the folder
+        @param value Value to be set
+    */
+    void setFloat(const std::string& name, const float value) const;
+    void setFloat(const UniformId id, const float value) const;
 
     /**
         Set 2D integer vector uniform inside the shader.
@@ -105,6 +171,7 @@ public:
         @param value Value to be set
     */
     void setVec2i(const std::string& name, const glm::ivec2& value) const;
+    void setVec2i(const UniformId id, const glm::ivec2& value) const;
 
     /**
         Set 2D float vector uniform inside the shader.
@@ -113,6 +180,7 @@ public:
         @param value Value to be set
     */
     void setVec2f(const std::string& name, const glm::vec2& value) const;
+    void setVec2f(const UniformId id, const glm::vec2& value) const;
 
     /**
         Set 3D float vector uniform inside the shader.
@@ -121,6 +189,7 @@ public:
         @param value Value to be set
     */
     void setVec3f(const std::string& name, const glm::vec3& value) const;
+    void setVec3f(const UniformId id, const glm::vec3& value) const;
 
     /**
         Set 4D float vector uniform inside the shader.
@@ -129,6 +198,7 @@ public:
         @param value Value to be set
     */
     void setVec4f(const std::string& name, const glm::vec4& value) const;
+    void setVec4f(const UniformId id, const glm::vec4& value) const;
 
     /**
         Set 4x4 matrix uniform inside the shader.
@@ -137,6 +207,7 @@ public:
         @param value Value to be set
     */
     void setMat4f(const std::string& name, const glm::mat4& value) const;
+    void setMat4f(const UniformId id, const glm::mat4& value) const;
 
 
     /**
@@ -146,6 +217,7 @@ public:
         @param values Vector containing the Values to be set
     */
     void setMat4fv(const std::string& name, const std::vector<glm::mat4>& values) const;
+    void setMat4fv(const UniformId id, const std::vector<glm::mat4>& values) const;
 
     /**
         Set 4x4 matrix array uniform inside the shader but only the values between [startIdx, endIdx).
@@ -157,6 +229,8 @@ public:
     */
     void setPartialMat4fv(const std::string& name, const int32_t startIdx,  const int32_t endIdx,
         const std::vector<glm::mat4>& values) const;
+    void setPartialMat4fv(const UniformId id, const int32_t startIdx,  const int32_t endIdx,
+        const std::vector<glm::mat4>& values) const;
 
     /**
         Get the current shader id.
@@ -171,14 +245,28 @@ private:
     Shader(const Shader& other) = delete;
     Shader& operator=(const Shader& other) = delete;
 
-    void setTexture(const std::string& name, const TextureUnitId texUnit, const uint32_t texId,
+    void setTexture(const UniformId id, const TextureUnitId texUnit, const uint32_t texId,
         const TextureTargetType type) const;
 
-    inline void handleNotFoundLocation(const std::string& name) const;
+    /* Uniform names known to any shader, ids index into names. Handles can be taken during static
+       initialization, so it's only created on first use. */
+    struct UniformRegistry
+    {
+        std::mutex mtx;
+        std::unordered_map<std::string, UniformId> ids;
+        std::vector<std::string> names;
+    };
+    static UniformRegistry& uniformRegistry();
+
+    inline void handleNotFoundLocation(const UniformId id) const;
+    UniformData* findUniform(const UniformId id) const;
+    bool updateShadow(UniformData& uniform, const int32_t firstElement, const int32_t elementCount,
+        const void* values) const;
 
 private:
     uint32_t shaderId_{0};
     Logger log_;
+    mutable UniformTable uniforms_;
     static uint32_t boundShaderId_;
 };
 } // namespace msgui
\ No newline at end of file
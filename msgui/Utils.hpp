@@ -3,11 +3,13 @@
 #include <memory>
 #include <string>
 #include <random>
+#include <type_traits>
 
 #include <glm/glm.hpp>
 
 #include "Logger.hpp"
 #include "msgui/node/AbstractNode.hpp"
+#include "msgui/node/NodePool.hpp"
 
 namespace msgui
 {
@@ -188,7 +190,8 @@ public:
     }
 
     /**
-        Easier variant to create a new node instead of std::make_shared each time.
+        Easier variant to create a new node instead of std::make_shared each time. Nodes are allocated from the
+        NodePool, other types fall back to std::make_shared.
 
         @param Type Type of node supplied as template argument
         @param args Type constructor arguments
@@ -198,7 +201,14 @@ public:
     template<typename Type, typename... Args>
     static std::shared_ptr<Type> make(Args&&... args)
     {
-        return std::make_shared<Type>(std::forward<Args>(args)...);
+        if constexpr (std::is_base_of_v<AbstractNode, Type>)
+        {
+            return std::allocate_shared<Type>(NodePoolAllocator<Type>{}, std::forward<Args>(args)...);
+        }
+        else
+        {
+            return std::make_shared<Type>(std::forward<Args>(args)...);
+        }
     }
 
     /**
@@ -6,5 +6,11 @@ struct INEvent
 {
     INEvent() = default;
     virtual ~INEvent() = default;
+
+    /* Keeps the event from reaching the next nodes on its capture -> target -> bubble path. Other channels of the
+       current node still get it. */
+    void stopPropagation() const { isPropagationStopped = true; }
+
+    mutable bool isPropagationStopped{false};
 };
 } // namespace msgui::event
@@ -7,10 +7,12 @@ namespace msgui::events
 {
 struct LMBItemRelease : public INEvent
 {
-    explicit LMBItemRelease(node::utils::ListItem* itemIn)
+    explicit LMBItemRelease(node::utils::ListItem* itemIn, const int32_t indexIn = -1)
         : item{itemIn}
+        , index{indexIn}
     {}
 
     node::utils::ListItem* item;
+    int32_t index;
 };
 } // namespace msgui::events
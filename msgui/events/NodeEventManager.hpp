@@ -1,10 +1,11 @@
 #pragma once
 
-#include <memory>
+#include <atomic>
+#include <cstdint>
 #include <functional>
-#include <map>
+#include <memory>
 #include <type_traits>
-#include <typeindex>
+#include <vector>
 
 #include "msgui/events/INodeEvent.hpp"
 #include "msgui/Logger.hpp"
@@ -18,73 +19,129 @@ struct InputChannel {};
 struct InternalChannel {};
 /* Channel dedicated to events coming from / going to the user itself. */
 struct UserChannel {};
+/* Channels for events propagating through the node. Capture fires on the way down to the target, bubble on the way
+   back up, for container nodes wanting to know about events hitting their children. */
+struct CaptureChannel {};
+struct BubbleChannel {};
+
+/* Event types get dense ids, handed out the first time each type is used. Ids index straight into the dispatch
+   tables below, there's no hashing or map lookup involved. */
+inline uint32_t nextEventTypeId()
+{
+    static std::atomic<uint32_t> nextId{0};
+    return nextId.fetch_add(1, std::memory_order_relaxed);
+}
+
+template<typename T>
+requires (std::is_base_of_v<INEvent, T>)
+inline uint32_t eventTypeId()
+{
+    static const uint32_t id = nextEventTypeId();
+    return id;
+}
+
+template<typename ChannelT>
+inline constexpr uint32_t channelIndex()
+{
+    if constexpr (std::is_same_v<ChannelT, InputChannel>) { return 0; }
+    else if constexpr (std::is_same_v<ChannelT, InternalChannel>) { return 1; }
+    else if constexpr (std::is_same_v<ChannelT, UserChannel>) { return 2; }
+    else if constexpr (std::is_same_v<ChannelT, CaptureChannel>) { return 3; }
+    else
+    {
+        static_assert(std::is_same_v<ChannelT, BubbleChannel>, "Unknown event channel");
+        return 4;
+    }
+}
 
 class NodeEventManager
 {
+using Callback = std::function<void(INEvent&)>;
 struct EventState
 {
     bool isKeyPaused{false};
-    std::function<void(INEvent&)> callback;
+    Callback callback;
+};
+
+/* Lives on the stack of each running dispatch. Lets the manager tell them it got destroyed while they run. */
+struct DispatchGuard
+{
+    DispatchGuard* outer{nullptr};
+    bool isAlive{true};
+    std::vector<EventState> retiredTable;
 };
 
 public:
+    static constexpr uint32_t CHANNEL_COUNT{5};
+    static constexpr uint32_t TARGET_CHANNEL_COUNT{3};
+
     NodeEventManager() = default;
+    ~NodeEventManager()
+    {
+        /* Destroyed by one of its own callbacks. Running callbacks live in the table, so the outermost dispatch takes
+           it over and frees it once the callbacks returned. Moving the vector keeps the callbacks where they are. */
+        for (DispatchGuard* guard = dispatchGuard_; guard; guard = guard->outer)
+        {
+            guard->isAlive = false;
+            if (!guard->outer) { guard->retiredTable = std::move(eventTable_); }
+        }
+    }
 
-    template<typename T, typename ChannelT = UserChannel>
+    /* Callbacks receive the event as const T&. Listening again replaces the previous callback. */
+    template<typename T, typename ChannelT = UserChannel, typename F>
     requires (std::is_base_of_v<INEvent, T>)
-    void listen(const std::function<void(const T)>& cb)
+    void listen(F&& cb)
     {
-        const auto key = computeKey<T, ChannelT>();
-        eventMap_[key].callback = [cb](INEvent& evt)
-        {
-            if (const auto derived = dynamic_cast<T*>(&evt))
+        setCallback(computeSlot<T, ChannelT>(),
+            [cb = std::forward<F>(cb)](INEvent& evt)
             {
-                cb(*derived);
-            }
-        };
+                /* Slots are per type, so whatever lands here is a T. */
+                cb(static_cast<const T&>(evt));
+            });
     }
 
     template<typename T, typename ChannelT = UserChannel>
     requires (std::is_base_of_v<INEvent, T>)
     void ignore()
     {
-        eventMap_.erase(computeKey<T, ChannelT>());
+        setCallback(computeSlot<T, ChannelT>(), nullptr);
     }
 
     template<typename T, typename ChannelT = UserChannel>
     requires (std::is_base_of_v<INEvent, T>)
     void notifyEvent(T& evt)
     {
-        const auto key = computeKey<T, ChannelT>();
-        if (!eventMap_.count(key)) { return; }
-
-        if (eventMap_[key].isKeyPaused) { return; }
-
-        eventMap_[key].callback(evt);
+        dispatch(computeSlot<T, ChannelT>(), evt);
     }
 
     template<typename T>
     requires (std::is_base_of_v<INEvent, T>)
     void notifyAllChannels(T& evt)
     {
-        notifyEvent<T, InputChannel>(evt);
-        notifyEvent<T, InternalChannel>(evt);
-        notifyEvent<T, UserChannel>(evt);
+        /* The target channels of a type sit next to each other, already in order of fire. */
+        const uint32_t firstSlot = computeSlot<T, InputChannel>();
+        if (firstSlot >= eventTable_.size()) { return; }
+
+        for (uint32_t slot = firstSlot; slot < firstSlot + TARGET_CHANNEL_COUNT; slot++)
+        {
+            /* Any callback can end up destroying the node owning this manager, stop right there if it does. */
+            if (!dispatch(slot, evt)) { return; }
+        }
     }
 
     template<typename T, typename ChannelT = UserChannel>
     void pauseEvent(const bool paused = true)
     {
-        const auto key = computeKey<T, ChannelT>();
-        if (!eventMap_.count(key)) { return; }
-        eventMap_[key].isKeyPaused = paused;
+        const uint32_t slot = computeSlot<T, ChannelT>();
+        if (slot >= eventTable_.size()) { return; }
+        eventTable_[slot].isKeyPaused = paused;
     }
 
     void pauseAllEvents(const bool paused = true)
     {
-        for (const auto&[key, value] : eventMap_)
+        for (EventState& state : eventTable_)
         {
-            eventMap_[key].isKeyPaused = paused;
+            state.isKeyPaused = paused;
         }
     }
 
@@ -95,17 +152,58 @@ private:
     NodeEventManager& operator=(NodeEventManager&&) = delete;
 
     template<typename T, typename ChannelT>
-    uint32_t computeKey()
+    uint32_t computeSlot()
+    {
+        return eventTypeId<T>() * CHANNEL_COUNT + channelIndex<ChannelT>();
+    }
+
+    /* Returns false if the manager got destroyed by the callback, nothing of it can be touched anymore then. */
+    bool dispatch(const uint32_t slot, INEvent& evt)
+    {
+        if (slot >= eventTable_.size()) { return true; }
+
+        const EventState& state = eventTable_[slot];
+        if (!state.callback || state.isKeyPaused) { return true; }
+
+        DispatchGuard guard{.outer = dispatchGuard_};
+        dispatchGuard_ = &guard;
+        state.callback(evt);
+        if (!guard.isAlive) { return false; }
+        dispatchGuard_ = guard.outer;
+
+        if (!dispatchGuard_ && !pendingCallbacks_.empty()) { applyPendingCallbacks(); }
+        return true;
+    }
+
+    void setCallback(const uint32_t slot, Callback&& callback)
     {
-        std::size_t hash1 = std::type_index(typeid(T)).hash_code();
-        std::size_t hash2 = std::type_index(typeid(ChannelT)).hash_code();
+        /* A running callback must not be moved or destroyed under itself, so changes made from inside callbacks wait
+           until dispatching is over. */
+        if (dispatchGuard_)
+        {
+            pendingCallbacks_.emplace_back(slot, std::move(callback));
+            return;
+        }
 
-        return static_cast<int>(hash1 * 31 + hash2);
+        if (slot >= eventTable_.size()) { eventTable_.resize(slot + 1); }
+        eventTable_[slot].callback = std::move(callback);
+    }
+
+    void applyPendingCallbacks()
+    {
+        std::vector<std::pair<uint32_t, Callback>> pending = std::move(pendingCallbacks_);
+        pendingCallbacks_.clear();
+        for (auto& [slot, callback] : pending)
+        {
+            setCallback(slot, std::move(callback));
+        }
     }
 
 private:
     Logger log_{"NodeEventManager"};
-    std::map<uint32_t, EventState> eventMap_;
+    std::vector<EventState> eventTable_;
+    std::vector<std::pair<uint32_t, Callback>> pendingCallbacks_;
+    DispatchGuard* dispatchGuard_{nullptr};
 };
 using NodeEventManagerPtr = std::shared_ptr<NodeEventManager>;
 }; // namespace msgui::events
\ No newline at end of file
@@ -1,7 +1,7 @@
 #include "BasicTextLayoutEngine.hpp"
 #include "msgui/Font.hpp"
-
-#include <glm/gtc/matrix_transform.hpp>
+#include "msgui/loaders/FontLoader.hpp"
+#include "msgui/renderer/GlyphAtlas.hpp"
 
 namespace msgui::layoutengine
 {
@@ -10,56 +10,97 @@ void BasicTextLayoutEngine::process(renderer::TextData& data, const bool forceAl
     /* No point in computing anything if the parent ain't event visible. */
     if (data.transformPtr->vScale.x <= 0 || data.transformPtr->vScale.y <= 0) { return; }
     
-    /* If the calculation is forced we must recalculate text data even if it's not dirty (from user pov). */
-    if (!data.isDirty && !forceAllDirty) { return; }
+    /* If the calculation is forced we must recalculate text data even if it's not dirty (from user pov). Same if
+       the node got moved or resized since the last time. */
+    const bool isTrChanged = data.transformPtr->pos != data.laidOutPos
+        || data.transformPtr->scale != data.laidOutScale;
+    if (!data.isDirty && !forceAllDirty && !isTrChanged) { return; }
 
     data.isDirty = false;
-    data.pcd.transform.clear();
-    data.pcd.unicodeIndex.clear();
+    data.laidOutPos = data.transformPtr->pos;
+    data.laidOutScale = data.transformPtr->scale;
+    data.pcd.glyphs.clear();
 
     float incZ = 0.001f;
     glm::ivec3 startPos = data.transformPtr->pos;
     data.textBounds = computeTextLengthAndHeight(data);
     FontPtr& fontData = data.fontData;
+    loaders::FontLoader& fontLoader = loaders::FontLoader::get();
 
+    /* SDF glyph metrics are in reference size units. Pen is kept in floats so scaled advances don't drift. */
+    const float scale = fontData->scale;
     startPos.x += data.transformPtr->scale.x * 0.5f - data.textBounds.x * 0.5f;
     startPos.y += data.transformPtr->scale.y * 0.5f - data.textBounds.y * 0.5f;
+    float penX = startPos.x;
     int32_t lineNo = 1;
-    for (char ch : data.text)
+    for (size_t idx = 0; idx < data.text.size();)
     {
         incZ += 0.001f;
-        const auto& cp = fontData->codePointData[uint32_t(ch)];
+        const auto& cp = fontLoader.getCodePoint(*fontData, decodeUtf8(data.text, idx));
         // if (startPos.x + cp.bearing.x + cp.size.x > data.transformPtr->pos.x + data.transformPtr->scale.x)
         // {
         //     startPos.x = data.transformPtr->pos.x;
         //     lineNo++;
         // }
-        const float x = startPos.x + cp.bearing.x;
-        const float y = startPos.y - cp.bearing.y + data.textBounds.y;// + fontData->fontSize * lineNo;
+        const float x = penX + cp.bearing.x * scale;
+        const float y = startPos.y - cp.bearing.y * scale + data.textBounds.y;// + fontData->fontSize * lineNo;
 
-        glm::mat4 modelMatrix = glm::mat4(1.0f);
-        modelMatrix = glm::translate(modelMatrix, glm::vec3{x, y, startPos.z + incZ});
-        modelMatrix = glm::scale(modelMatrix, glm::vec3{fontData->fontSize, fontData->fontSize, 1});
+        penX += (cp.hAdvance >> 6) * scale;
 
-        int32_t advance = cp.hAdvance >> 6;
-        startPos.x += advance;
+        /* Glyphs without a bitmap (spaces) only advance the pen. */
+        if (cp.atlasSlot == renderer::GlyphAtlas::EMPTY_SLOT) { continue; }
 
-        data.pcd.transform.emplace_back(std::move(modelMatrix));
-        data.pcd.unicodeIndex.push_back(ch);
+        /* Glyph size & texture rect are looked up by the renderer using the atlas slot. */
+        data.pcd.glyphs.emplace_back(renderer::GlyphInstanceData{
+            .pos = glm::vec3{x, y, startPos.z + incZ},
+            .glyphAndText = cp.atlasSlot});
     }
 }
 
 glm::ivec2 BasicTextLayoutEngine::computeTextLengthAndHeight(const renderer::TextData& data) const
 {
     const auto fontData = data.fontData;
+    loaders::FontLoader& fontLoader = loaders::FontLoader::get();
+
+    /* SDF bitmaps are padded with the spread, it's not part of the visible glyph height. */
+    const int32_t spread = fontData->isSdf ? SDF_SPREAD : 0;
+    glm::vec2 result{0, 0};
+    for (size_t idx = 0; idx < data.text.size();)
+    {
+        const auto& cp = fontLoader.getCodePoint(*fontData, decodeUtf8(data.text, idx));
+        result.x += (cp.hAdvance >> 6) * fontData->scale;
+        // We only need max height for horizontal text.
+        result.y = std::max(result.y, (cp.bearing.y - spread) * fontData->scale);
+    }
+    return glm::round(result);
+}
+
+uint32_t BasicTextLayoutEngine::decodeUtf8(const std::string& text, size_t& idx)
+{
+    const uint8_t lead = text[idx++];
+    if (lead < 0x80) { return lead; }
+
+    /* Number of continuation bytes & the payload bits of the lead byte. */
+    int32_t extra = 0;
+    uint32_t codePoint = 0;
+    if ((lead & 0xE0) == 0xC0) { extra = 1; codePoint = lead & 0x1F; }
+    else if ((lead & 0xF0) == 0xE0) { extra = 2; codePoint = lead & 0x0F; }
+    else if ((lead & 0xF8) == 0xF0) { extra = 3; codePoint = lead & 0x07; }
+    else { return REPLACEMENT_CODEPOINT; }
+
+    for (int32_t i = 0; i < extra; i++)
+    {
+        /* Truncated sequence, resume decoding from the offending byte. */
+        if (idx >= text.size() || (uint8_t(text[idx]) & 0xC0) != 0x80) { return REPLACEMENT_CODEPOINT; }
+        codePoint = (codePoint << 6) | (uint8_t(text[idx++]) & 0x3F);
+    }
 
-    glm::ivec2 result{0, 0};
-    for (const char ch : data.text)
+    /* Reject overlong encodings, surrogates & anything past the unicode range. */
+    static constexpr uint32_t minForLength[] = {0, 0x80, 0x800, 0x10000};
+    if (codePoint < minForLength[extra] || (codePoint >= 0xD800 && codePoint <= 0xDFFF) || codePoint > 0x10FFFF)
     {
-        const auto& cp = fontData->codePointData[uint32_t(ch)];
-        result.x += cp.hAdvance >> 6;
-        result.y = std::max(result.y, cp.bearing.y - 0); // We only need max height for horizontal text.
+        return REPLACEMENT_CODEPOINT;
     }
-    return result;
+    return codePoint;
 }
 } // namespace msgui::layoutengine
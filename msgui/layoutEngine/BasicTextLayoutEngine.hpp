@@ -14,6 +14,18 @@ public:
 private:
     glm::ivec2 computeTextLengthAndHeight(const renderer::TextData& data) const;
 
+    /**
+        Decode the UTF-8 sequence starting at idx. Malformed sequences decode to the replacement character.
+
+        @param text Text to decode from
+        @param idx Start of the sequence, gets moved past it
+
+        @return Decoded codepoint
+    */
+    static uint32_t decodeUtf8(const std::string& text, size_t& idx);
+
+    static constexpr uint32_t REPLACEMENT_CODEPOINT{0xFFFD};
+
 private:
     Logger log_{"SimpleTextLayoutEngine"};
 };
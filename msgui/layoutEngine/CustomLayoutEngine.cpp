@@ -77,6 +77,25 @@ using Void = CustomLayoutEngine::Void;
     can return error messages that shall halt the layout calculation of that node.
 */
 Result<Void> CustomLayoutEngine::process(const AbstractNodePtr& node)
+{
+    return processInternal(node, nullptr);
+}
+
+Result<Void> CustomLayoutEngine::process(const AbstractNodePtr& node, PendingOverflows& pendingOverflows)
+{
+    return processInternal(node, &pendingOverflows);
+}
+
+void CustomLayoutEngine::applyPendingOverflows(PendingOverflows& pendingOverflows)
+{
+    for (const PendingOverflow& pending : pendingOverflows)
+    {
+        Utils::as<Box>(pending.node)->setOverflow(pending.overflow);
+    }
+    pendingOverflows.clear();
+}
+
+Result<Void> CustomLayoutEngine::processInternal(const AbstractNodePtr& node, PendingOverflows* pendingOverflows)
 {
     const AbstractNode::NodeType nodeType = node->getType();
     const Layout& layout = node->getLayout();
@@ -117,7 +136,7 @@ Result<Void> CustomLayoutEngine::process(const AbstractNodePtr& node)
         const Result<Void>& scaleResult = computeSubNodesScale(node, sc.value);
         RETURN_ON_ERROR(scaleResult, Void);
 
-        const Result<glm::vec2>& posResult = computeSubNodesPosition(node, sc.value);
+        const Result<glm::vec2>& posResult = computeSubNodesPosition(node, sc.value, pendingOverflows);
         RETURN_ON_ERROR(posResult, Void);
     }
     /* Handling of grid layouts */
@@ -360,9 +379,13 @@ Result<Void> CustomLayoutEngine::computeSubNodesScale(const AbstractNodePtr& nod
     Leaf subNodes are REQUIRED to be of scale type PX, otherwise it is impossible to compute the FIT scale of the
     initial node.
     This function WILL NOT set any scale for any node/subNode, it just tries to compute the minimum gift-wrapped scale.
+    The result only depends on the layout data of the node and its subNodes, so it is cached per node until any of
+    those change. Nested FIT nodes get measured only once instead of once per FIT ancestor.
 */
 Result<glm::vec2> CustomLayoutEngine::computeFitScale(const AbstractNodePtr& node)
 {
+    if (node->isFitScaleValid_) { return Result<glm::vec2>{ .value = node->fitScale_ }; }
+
     const Layout& layout = node->getLayout();
     const bool isLayoutHorizontal = layout.type == Layout::Type::HORIZONTAL;
     AbstractNodePVec& subNodes = node->getChildren();
@@ -495,6 +518,9 @@ Result<glm::vec2> CustomLayoutEngine::computeFitScale(const AbstractNodePtr& nod
     scaleNeeded.x += layout.padding.left + layout.padding.right + layout.border.left + layout.border.right;
     scaleNeeded.y += layout.padding.top + layout.padding.bot + layout.border.top + layout.border.bot;
 
+    node->fitScale_ = scaleNeeded;
+    node->isFitScaleValid_ = true;
+
     return Result<glm::vec2>{ .value = scaleNeeded };
 }
 
@@ -514,7 +540,7 @@ Result<glm::vec2> CustomLayoutEngine::computeFitScale(const AbstractNodePtr& nod
     Scrollbars will also be positioned at this stage as they are subNodes of Box derived nodes.
 */
 Result<glm::vec2> CustomLayoutEngine::computeSubNodesPosition(const AbstractNodePtr& node,
-    const ScrollContribution& sc)
+    const ScrollContribution& sc, PendingOverflows* pendingOverflows)
 {
     const Layout& layout = node->getLayout();
     const bool isLayoutHorizontal = layout.type == Layout::Type::HORIZONTAL;
@@ -645,7 +671,7 @@ Result<glm::vec2> CustomLayoutEngine::computeSubNodesPosition(const AbstractNode
         Apply any overflow shifting as needed. Only Box and Box derived types support overflow handling.
         Like RecycleLists/TreeViews.
     */
-    applyOverflowAndScrollOffsets(node, overflow, sc);
+    applyOverflowAndScrollOffsets(node, overflow, sc, pendingOverflows);
 
     return Result<glm::vec2>{.value = overflow};
 }
@@ -778,17 +804,24 @@ Result<Void> CustomLayoutEngine::selfAlignSubNodeSlice(const AbstractNodePtr& no
 /*
     Function simply shifts all the subNode positions by overflow amount in order to simulate scrolling
     and additionally updates the internal node overflow value. This is effective only for Box nodes or derived of it.
+    When pending overflows are given, the overflow value update is only collected there to be applied later.
 */
 void CustomLayoutEngine::applyOverflowAndScrollOffsets(const AbstractNodePtr& node, const glm::vec2 overflow,
-    const ScrollContribution& sc)
+    const ScrollContribution& sc, PendingOverflows* pendingOverflows)
 {
     if (node->getType() != AbstractNode::NodeType::BOX)
     {
         return;
     }
 
-    const BoxPtr& box = Utils::as<Box>(node);
-    box->setOverflow(overflow);
+    if (pendingOverflows)
+    {
+        pendingOverflows->emplace_back(PendingOverflow{.node = node, .overflow = overflow});
+    }
+    else
+    {
+        Utils::as<Box>(node)->setOverflow(overflow);
+    }
 
     if (sc.offset.x < 0 && sc.offset.y < 0)
     {
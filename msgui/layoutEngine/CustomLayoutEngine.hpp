@@ -18,6 +18,25 @@ public:
      */
     Result<Void> process(const AbstractNodePtr& node) override;
 
+    /**
+        Process the layout for the current node but only collect overflow updates instead of applying them. Nodes
+        from different subtrees can be processed concurrently this way, except for RecycleList and TreeView nodes
+        as they create their items during processing.
+
+        @param node Node on which the layour calculations will be performed
+        @param pendingOverflows Collected overflow updates
+     */
+    Result<Void> process(const AbstractNodePtr& node, PendingOverflows& pendingOverflows) override;
+
+    /**
+        Apply overflow updates collected while processing nodes.
+
+        @note Must be called from the main thread.
+
+        @param pendingOverflows Overflow updates to apply. Gets cleared afterwards
+     */
+    void applyPendingOverflows(PendingOverflows& pendingOverflows) override;
+
 private:
     struct ScrollContribution
     {
@@ -26,14 +45,16 @@ private:
     };
 
     /* Common */
+    Result<Void> processInternal(const AbstractNodePtr& node, PendingOverflows* pendingOverflows);
     Result<Void> computeSubNodesScale(const AbstractNodePtr& node, const ScrollContribution& sc);
-    Result<glm::vec2> computeSubNodesPosition(const AbstractNodePtr& node, const ScrollContribution& sc);
+    Result<glm::vec2> computeSubNodesPosition(const AbstractNodePtr& node, const ScrollContribution& sc,
+        PendingOverflows* pendingOverflows);
     Result<glm::vec2> computeFitScale(const AbstractNodePtr& node);
     Result<Void> alignSubNodes(const AbstractNodePtr& node, const glm::vec2 computedOverflow);
     Result<Void> selfAlignSubNodeSlice(const AbstractNodePtr& node, const glm::vec2 maximum,
         const uint32_t startIdx, const uint32_t endIdx);
     void applyOverflowAndScrollOffsets(const AbstractNodePtr& node, const glm::vec2 overflow,
-        const ScrollContribution& sc);
+        const ScrollContribution& sc, PendingOverflows* pendingOverflows);
     glm::vec2 computeOverflow(const AbstractNodePtr& node, const ScrollContribution& sc);
     Result<Void> computeGridLayout(const AbstractNodePtr& node);
     Result<Void> updateGridFracPart(const AbstractNodePtr& node);
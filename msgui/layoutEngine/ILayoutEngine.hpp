@@ -1,6 +1,9 @@
 #pragma once
 
 #include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
 
 #include "msgui/node/AbstractNode.hpp"
 
@@ -18,8 +21,19 @@ public:
 
     struct Void{};
 
+    /* Overflow computed for a Box node. Applying it can add/remove scrollbars and notify the frame, which is not
+       safe to do from multiple threads, so parallel layout collects it and applies it afterwards. */
+    struct PendingOverflow
+    {
+        AbstractNodePtr node{nullptr};
+        glm::ivec2 overflow{0};
+    };
+    using PendingOverflows = std::vector<PendingOverflow>;
+
 public:
     virtual Result<Void> process(const AbstractNodePtr& node) = 0;
+    virtual Result<Void> process(const AbstractNodePtr& node, PendingOverflows& pendingOverflows) = 0;
+    virtual void applyPendingOverflows(PendingOverflows& pendingOverflows) = 0;
 };
 
 using ILayoutEnginePtr = std::shared_ptr<ILayoutEngine>;
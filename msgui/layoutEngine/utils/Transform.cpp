@@ -5,6 +5,20 @@
 
 namespace msgui::layoutengine::utils
 {
+Transform::Transform()
+    : slot(TransformStore::get().acquire())
+    , pos(TransformStore::get().pos(slot))
+    , scale(TransformStore::get().scale(slot))
+    , vPos(TransformStore::get().vPos(slot))
+    , vScale(TransformStore::get().vScale(slot))
+    , modelMatrix(TransformStore::get().modelMatrix(slot))
+{}
+
+Transform::~Transform()
+{
+    TransformStore::get().release(slot);
+}
+
 glm::mat4& Transform::computeModelMatrix()
 {
     modelMatrix = glm::mat4(1.0f);
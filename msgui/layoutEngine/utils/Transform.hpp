@@ -3,13 +3,18 @@
 #include <glm/glm.hpp>
 
 #include "msgui/layoutEngine/utils/LayoutData.hpp"
+#include "msgui/layoutEngine/utils/TransformStore.hpp"
 
 namespace msgui::layoutengine::utils
 {
-/* Holds & computes position and scale info */
+/* Holds & computes position and scale info. Fields are views into the TransformStore slot owned by this transform,
+   nodes keep the transform while hot passes can go over the store arrays directly by slot. */
 struct Transform
 {
 public:
+    Transform();
+    ~Transform();
+
     /**
         Compute the model matrix based on current scale and position.
 
@@ -27,12 +32,20 @@ public:
     */
     void computeViewableArea(const Transform& otherTrans, const utils::Layout::TBLR& otherBorder);
 
+private:
+    /* Cannot be copied or moved, the slot belongs to this transform only */
+    Transform(const Transform&) = delete;
+    Transform(Transform&&) = delete;
+    Transform& operator=(const Transform&) = delete;
+    Transform& operator=(Transform&&) = delete;
+
 public:
-    glm::vec3 pos{0, 0, 1};
-    glm::vec3 scale{1};
-    glm::ivec2 vPos{0};
-    glm::ivec2 vScale{0};
-    glm::mat4 modelMatrix;
+    const uint32_t slot;
+    glm::vec3& pos;
+    glm::vec3& scale;
+    glm::ivec2& vPos;
+    glm::ivec2& vScale;
+    glm::mat4& modelMatrix;
 };
 using TransformPtr = Transform*;
 } // namespace msgui::layoutengine::utils
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include "TransformStore.hpp"
+
+#include <cstdlib>
+
+namespace msgui::layoutengine::utils
+{
+TransformStore& TransformStore::get()
+{
+    /* Never destroyed on purpose. Nodes owned by other singletons can outlive a function local static and they
+       still need to release their slots. */
+    static TransformStore* instance = new TransformStore;
+    return *instance;
+}
+
+uint32_t TransformStore::acquire()
+{
+    uint32_t slot{0};
+    {
+        std::unique_lock lock{mtx_};
+        if (!freeSlots_.empty())
+        {
+            slot = freeSlots_.back();
+            freeSlots_.pop_back();
+        }
+        else
+        {
+            slot = slotCount_++;
+            const uint32_t chunkIdx = slot >> CHUNK_SHIFT;
+            if (chunkIdx >= MAX_CHUNKS)
+            {
+                log_.errorLn("Out of transform slots (%u)", slot);
+                exit(1);
+            }
+
+            if (!chunks_[chunkIdx]) { chunks_[chunkIdx] = std::make_unique<Chunk>(); }
+        }
+    }
+
+    pos(slot) = {0, 0, 1};
+    scale(slot) = glm::vec3{1};
+    vPos(slot) = glm::ivec2{0};
+    vScale(slot) = glm::ivec2{0};
+    modelMatrix(slot) = glm::mat4{1.0f};
+    clipInset(slot) = glm::ivec4{0};
+    return slot;
+}
+
+void TransformStore::release(const uint32_t slot)
+{
+    std::unique_lock lock{mtx_};
+    freeSlots_.push_back(slot);
+}
+
+uint32_t TransformStore::getSlotCount() const
+{
+    std::unique_lock lock{mtx_};
+    return slotCount_;
+}
+} // namespace msgui::layoutengine::utils
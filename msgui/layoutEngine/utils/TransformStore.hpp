@@ -0,0 +1,90 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "msgui/Logger.hpp"
+
+namespace msgui::layoutengine::utils
+{
+/* Structure of arrays holding the transform fields of all nodes. Each node owns a slot and the fields of that slot
+   live in separate contiguous arrays, so passes touching only positions or viewable areas stream through memory
+   instead of dragging whole nodes through the cache. Storage grows in fixed chunks so that addresses handed out
+   stay valid for the lifetime of the slot. */
+class TransformStore
+{
+public:
+    static constexpr uint32_t CHUNK_SHIFT{12};
+    static constexpr uint32_t CHUNK_SIZE{1 << CHUNK_SHIFT};
+    static constexpr uint32_t CHUNK_MASK{CHUNK_SIZE - 1};
+    static constexpr uint32_t MAX_CHUNKS{1024};
+
+    static TransformStore& get();
+
+    /**
+        Acquire a slot and reset its fields to the transform defaults. Released slots get reused first.
+
+        @return Slot index
+    */
+    uint32_t acquire();
+
+    /**
+        Give back a slot so it can be reused by future transforms.
+
+        @param slot Slot to release
+    */
+    void release(const uint32_t slot);
+
+    /**
+        Get the number of slots ever handed out. Slots in [0, getSlotCount()) are addressable, released ones included.
+
+        @return Slot count
+    */
+    uint32_t getSlotCount() const;
+
+    /* Field accessors. Slot must have been acquired. */
+    inline glm::vec3& pos(const uint32_t slot) { return chunk(slot).pos[slot & CHUNK_MASK]; }
+    inline glm::vec3& scale(const uint32_t slot) { return chunk(slot).scale[slot & CHUNK_MASK]; }
+    inline glm::ivec2& vPos(const uint32_t slot) { return chunk(slot).vPos[slot & CHUNK_MASK]; }
+    inline glm::ivec2& vScale(const uint32_t slot) { return chunk(slot).vScale[slot & CHUNK_MASK]; }
+    inline glm::mat4& modelMatrix(const uint32_t slot) { return chunk(slot).modelMatrix[slot & CHUNK_MASK]; }
+
+    /* Area the subNodes are viewable in is the viewable area of the slot shrunk by this inset. Holds
+       (left, top, left + right, top + bot) of the border. */
+    inline glm::ivec4& clipInset(const uint32_t slot) { return chunk(slot).clipInset[slot & CHUNK_MASK]; }
+
+private:
+    /* Cannot be copied or moved */
+    TransformStore() = default;
+    TransformStore(const TransformStore&) = delete;
+    TransformStore(TransformStore&&) = delete;
+    TransformStore& operator=(const TransformStore&) = delete;
+    TransformStore& operator=(TransformStore&&) = delete;
+
+    struct Chunk
+    {
+        std::array<glm::vec3, CHUNK_SIZE> pos;
+        std::array<glm::vec3, CHUNK_SIZE> scale;
+        std::array<glm::ivec2, CHUNK_SIZE> vPos;
+        std::array<glm::ivec2, CHUNK_SIZE> vScale;
+        std::array<glm::mat4, CHUNK_SIZE> modelMatrix;
+        std::array<glm::ivec4, CHUNK_SIZE> clipInset;
+    };
+
+    inline Chunk& chunk(const uint32_t slot) { return *chunks_[slot >> CHUNK_SHIFT]; }
+
+private:
+    Logger log_{"TransformStore"};
+
+    /* Chunk table never reallocates, so readers don't race with slots being acquired from other threads. */
+    std::array<std::unique_ptr<Chunk>, MAX_CHUNKS> chunks_;
+    std::vector<uint32_t> freeSlots_;
+    uint32_t slotCount_{0};
+    mutable std::mutex mtx_;
+};
+} // namespace msgui::layoutengine::utils
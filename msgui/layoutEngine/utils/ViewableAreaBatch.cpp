@@ -0,0 +1,164 @@
+#include "ViewableAreaBatch.hpp"
+
+#include <algorithm>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "msgui/layoutEngine/utils/TransformStore.hpp"
+
+namespace msgui::layoutengine::utils
+{
+namespace
+{
+/* Same math as Transform::computeViewableArea() for a single axis: start is the truncated position pushed inside the
+   bound, size is whatever is left until the nearest of the two ends. */
+void clipAxis(const float* pos, const float* end, const float* boundMin, const float* boundMax, int32_t* outPos,
+    int32_t* outScale, const uint32_t count)
+{
+    uint32_t i = 0;
+#if defined(__AVX__)
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256 truncPos = _mm256_cvtepi32_ps(_mm256_cvttps_epi32(_mm256_loadu_ps(pos + i)));
+        const __m256 vPos = _mm256_max_ps(_mm256_loadu_ps(boundMin + i), truncPos);
+        const __m256 vEnd = _mm256_min_ps(_mm256_loadu_ps(boundMax + i), _mm256_loadu_ps(end + i));
+        _mm256_storeu_si256((__m256i*)(outPos + i), _mm256_cvttps_epi32(vPos));
+        _mm256_storeu_si256((__m256i*)(outScale + i), _mm256_cvttps_epi32(_mm256_sub_ps(vEnd, vPos)));
+    }
+#endif
+#if defined(__SSE2__)
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 truncPos = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_loadu_ps(pos + i)));
+        const __m128 vPos = _mm_max_ps(_mm_loadu_ps(boundMin + i), truncPos);
+        const __m128 vEnd = _mm_min_ps(_mm_loadu_ps(boundMax + i), _mm_loadu_ps(end + i));
+        _mm_storeu_si128((__m128i*)(outPos + i), _mm_cvttps_epi32(vPos));
+        _mm_storeu_si128((__m128i*)(outScale + i), _mm_cvttps_epi32(_mm_sub_ps(vEnd, vPos)));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        const int32_t vPos = std::max((int32_t)boundMin[i], (int32_t)pos[i]);
+        outPos[i] = vPos;
+        outScale[i] = std::min(boundMax[i], end[i]) - vPos;
+    }
+}
+} // namespace
+
+void ViewableAreaBatch::add(const uint32_t level, const uint32_t slot, const uint32_t boundSlot,
+    const bool isInsetIgnored)
+{
+    if (slot >= positions_.size()) { positions_.resize(slot + 1); }
+    if (positions_[slot].idx != NOT_ADDED) { remove(slot); }
+    if (level >= levels_.size()) { levels_.resize(level + 1); }
+
+    Level& lvl = levels_[level];
+    positions_[slot] = Position{.level = level, .idx = (uint32_t)lvl.slots.size()};
+    lvl.slots.push_back(slot);
+    lvl.boundSlots.push_back(boundSlot);
+    lvl.isInsetIgnored.push_back(isInsetIgnored);
+    size_++;
+}
+
+void ViewableAreaBatch::remove(const uint32_t slot)
+{
+    if (slot >= positions_.size() || positions_[slot].idx == NOT_ADDED) { return; }
+
+    /* Last transform of the level takes the place of the removed one. */
+    Position& pos = positions_[slot];
+    Level& lvl = levels_[pos.level];
+    const uint32_t lastIdx = lvl.slots.size() - 1;
+    if (pos.idx != lastIdx)
+    {
+        lvl.slots[pos.idx] = lvl.slots[lastIdx];
+        lvl.boundSlots[pos.idx] = lvl.boundSlots[lastIdx];
+        lvl.isInsetIgnored[pos.idx] = lvl.isInsetIgnored[lastIdx];
+        positions_[lvl.slots[pos.idx]].idx = pos.idx;
+    }
+    lvl.slots.pop_back();
+    lvl.boundSlots.pop_back();
+    lvl.isInsetIgnored.pop_back();
+    pos.idx = NOT_ADDED;
+    size_--;
+}
+
+void ViewableAreaBatch::compute()
+{
+    for (const auto& level : levels_)
+    {
+        if (level.slots.empty()) { continue; }
+
+        packLevel(level);
+        clipPacked(level.slots.size());
+        unpackLevel(level);
+    }
+}
+
+uint32_t ViewableAreaBatch::getSize() const { return size_; }
+
+void ViewableAreaBatch::packLevel(const Level& level)
+{
+    const uint32_t count = level.slots.size();
+    if (posX_.size() < count)
+    {
+        for (auto* arr : {&posX_, &posY_, &endX_, &endY_, &boundMinX_, &boundMinY_, &boundMaxX_, &boundMaxY_})
+        {
+            arr->resize(count);
+        }
+        for (auto* arr : {&outPosX_, &outPosY_, &outScaleX_, &outScaleY_})
+        {
+            arr->resize(count);
+        }
+    }
+
+    TransformStore& store = TransformStore::get();
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const glm::vec3& pos = store.pos(level.slots[i]);
+        const glm::vec3& scale = store.scale(level.slots[i]);
+
+        /* Available viewing space shrinks with bound's inset (border) unless told otherwise */
+        const uint32_t boundSlot = level.boundSlots[i];
+        glm::ivec2 boundPos = store.vPos(boundSlot);
+        glm::ivec2 boundScale = store.vScale(boundSlot);
+        if (!level.isInsetIgnored[i])
+        {
+            const glm::ivec4& inset = store.clipInset(boundSlot);
+            boundPos += glm::ivec2{inset.x, inset.y};
+            boundScale -= glm::ivec2{inset.z, inset.w};
+        }
+
+        posX_[i] = pos.x;
+        posY_[i] = pos.y;
+        endX_[i] = pos.x + scale.x;
+        endY_[i] = pos.y + scale.y;
+        boundMinX_[i] = boundPos.x;
+        boundMinY_[i] = boundPos.y;
+        boundMaxX_[i] = boundPos.x + boundScale.x;
+        boundMaxY_[i] = boundPos.y + boundScale.y;
+    }
+}
+
+void ViewableAreaBatch::clipPacked(const uint32_t count)
+{
+    clipAxis(posX_.data(), endX_.data(), boundMinX_.data(), boundMaxX_.data(), outPosX_.data(), outScaleX_.data(),
+        count);
+    clipAxis(posY_.data(), endY_.data(), boundMinY_.data(), boundMaxY_.data(), outPosY_.data(), outScaleY_.data(),
+        count);
+}
+
+void ViewableAreaBatch::unpackLevel(const Level& level)
+{
+    TransformStore& store = TransformStore::get();
+    const uint32_t count = level.slots.size();
+    for (uint32_t i = 0; i < count; i++)
+    {
+        store.vPos(level.slots[i]) = {outPosX_[i], outPosY_[i]};
+        store.vScale(level.slots[i]) = {outScaleX_[i], outScaleY_[i]};
+    }
+}
+} // namespace msgui::layoutengine::utils
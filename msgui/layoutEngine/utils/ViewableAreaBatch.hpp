@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace msgui::layoutengine::utils
+{
+/* Computes the viewable area of many transforms in one sweep. Transforms are grouped by tree level so the areas
+   bounding a level are final by the time it gets processed. Each level is packed from the TransformStore into flat
+   arrays and clipped with SSE2, or AVX when built with MSGUI_ENABLE_AVX, scalar code otherwise. Transforms are added
+   and removed one by one as nodes join or leave a frame. */
+class ViewableAreaBatch
+{
+public:
+    /**
+        Add a transform whose viewable area needs to be computed.
+
+        @param level Tree level of the transform. Its bounding transform must be on a lower level
+        @param slot Store slot of the transform
+        @param boundSlot Store slot of the transform bounding the viewable area of this one
+        @param isInsetIgnored If true, whole viewable area of the bound is used instead of the area inside its inset
+    */
+    void add(const uint32_t level, const uint32_t slot, const uint32_t boundSlot, const bool isInsetIgnored);
+
+    /**
+        Remove a previously added transform. Nothing happens if it was never added.
+
+        @param slot Store slot of the transform
+    */
+    void remove(const uint32_t slot);
+
+    /**
+        Compute the viewable area of all added transforms, lowest level first.
+    */
+    void compute();
+
+    /**
+        Get the number of transforms added.
+
+        @return Number of transforms
+    */
+    uint32_t getSize() const;
+
+private:
+    struct Level
+    {
+        std::vector<uint32_t> slots;
+        std::vector<uint32_t> boundSlots;
+        std::vector<uint8_t> isInsetIgnored;
+    };
+
+    static constexpr uint32_t NOT_ADDED = UINT32_MAX;
+
+    struct Position
+    {
+        uint32_t level{0};
+        uint32_t idx{NOT_ADDED};
+    };
+
+    void packLevel(const Level& level);
+    void clipPacked(const uint32_t count);
+    void unpackLevel(const Level& level);
+
+private:
+    std::vector<Level> levels_;
+    std::vector<Position> positions_;
+    uint32_t size_{0};
+
+    /* Packed scratch arrays, reused between passes */
+    std::vector<float> posX_;
+    std::vector<float> posY_;
+    std::vector<float> endX_;
+    std::vector<float> endY_;
+    std::vector<float> boundMinX_;
+    std::vector<float> boundMinY_;
+    std::vector<float> boundMaxX_;
+    std::vector<float> boundMaxY_;
+    std::vector<int32_t> outPosX_;
+    std::vector<int32_t> outPosY_;
+    std::vector<int32_t> outScaleX_;
+    std::vector<int32_t> outScaleY_;
+};
+} // namespace msgui::layoutengine::utils
@@ -0,0 +1,153 @@
+#include "WorkStealingPool.hpp"
+
+#include <algorithm>
+
+namespace msgui::layoutengine::utils
+{
+WorkStealingPool::WorkStealingPool(const int32_t workerCount)
+{
+    const int32_t count = std::max(workerCount, 1);
+    for (int32_t i = 0; i < count; i++)
+    {
+        queues_.emplace_back(std::make_unique<WorkerQueue>());
+    }
+
+    /* Worker zero is whoever calls runAll(). */
+    for (int32_t i = 1; i < count; i++)
+    {
+        threads_.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::unique_lock lock{wakeMtx_};
+        isStopping_ = true;
+    }
+    wakeCv_.notify_all();
+
+    for (auto& thread : threads_)
+    {
+        thread.join();
+    }
+}
+
+void WorkStealingPool::push(const int32_t workerIdx, Task&& task)
+{
+    /* Counted before being visible so that the pool never looks idle while tasks are still queued. */
+    pendingTasks_++;
+
+    {
+        WorkerQueue& queue = *queues_[workerIdx];
+        std::unique_lock lock{queue.mtx};
+        queue.tasks.emplace_back(std::move(task));
+    }
+    queuedTasks_++;
+
+    /* Idle workers count themselves before checking for queued tasks, so either they see this one or we see them.
+       Taking the lock makes sure the woken up worker is either waiting already or hasn't checked yet. */
+    if (idleWorkers_ > 0)
+    {
+        { std::unique_lock lock{idleMtx_}; }
+        idleCv_.notify_one();
+    }
+}
+
+void WorkStealingPool::runAll()
+{
+    if (pendingTasks_ == 0) { return; }
+
+    {
+        std::unique_lock lock{wakeMtx_};
+        generation_++;
+    }
+    wakeCv_.notify_all();
+
+    drain(0);
+}
+
+int32_t WorkStealingPool::getWorkerCount() const { return queues_.size(); }
+
+void WorkStealingPool::workerLoop(const int32_t workerIdx)
+{
+    uint64_t lastGeneration = 0;
+    while (true)
+    {
+        {
+            std::unique_lock lock{wakeMtx_};
+            wakeCv_.wait(lock, [this, lastGeneration]() { return isStopping_ || generation_ != lastGeneration; });
+            if (isStopping_) { return; }
+            lastGeneration = generation_;
+        }
+
+        drain(workerIdx);
+    }
+}
+
+void WorkStealingPool::drain(const int32_t workerIdx)
+{
+    Task task;
+    while (pendingTasks_ > 0)
+    {
+        if (!popOrSteal(workerIdx, task))
+        {
+            /* Others are still running tasks that might push new ones. */
+            waitForTasks();
+            continue;
+        }
+
+        task(workerIdx);
+        task = nullptr;
+
+        /* Only done once the task finished, so whatever it pushed is already counted. Last one wakes everybody up
+           so they can leave the drain. */
+        if (pendingTasks_.fetch_sub(1) == 1)
+        {
+            { std::unique_lock lock{idleMtx_}; }
+            idleCv_.notify_all();
+        }
+    }
+}
+
+void WorkStealingPool::waitForTasks()
+{
+    std::unique_lock lock{idleMtx_};
+    idleWorkers_++;
+    idleCv_.wait(lock, [this]() { return pendingTasks_ == 0 || queuedTasks_ > 0; });
+    idleWorkers_--;
+}
+
+bool WorkStealingPool::popOrSteal(const int32_t workerIdx, Task& outTask)
+{
+    /* Own queue is used as a stack, tasks pushed last are the most likely to be hot in cache. */
+    {
+        WorkerQueue& queue = *queues_[workerIdx];
+        std::unique_lock lock{queue.mtx};
+        if (!queue.tasks.empty())
+        {
+            outTask = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            queuedTasks_--;
+            return true;
+        }
+    }
+
+    /* Steal the oldest task of someone else, usually the biggest chunk of work left. */
+    const int32_t count = queues_.size();
+    for (int32_t i = 1; i < count; i++)
+    {
+        WorkerQueue& queue = *queues_[(workerIdx + i) % count];
+        std::unique_lock lock{queue.mtx};
+        if (!queue.tasks.empty())
+        {
+            outTask = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            queuedTasks_--;
+            return true;
+        }
+    }
+
+    return false;
+}
+} // namespace msgui::layoutengine::utils
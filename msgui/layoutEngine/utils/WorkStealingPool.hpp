@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace msgui::layoutengine::utils
+{
+/* Pool of workers each owning a task queue. Workers pop tasks from the back of their own queue and steal from the
+   front of the others' once they run dry, so tasks pushing more tasks balance themselves across the workers. */
+class WorkStealingPool
+{
+public:
+    using Task = std::function<void(const int32_t workerIdx)>;
+
+    /**
+        Creates the pool. The thread calling runAll() acts as worker zero, so only workerCount - 1 threads are spawned.
+
+        @param workerCount Number of workers, including the calling thread
+    */
+    explicit WorkStealingPool(const int32_t workerCount);
+    ~WorkStealingPool();
+
+    /**
+        Push a task onto the queue of a worker. Can be called from inside running tasks.
+
+        @param workerIdx Index of the worker whose queue gets the task
+        @param task Task to run. Receives the index of the worker running it
+    */
+    void push(const int32_t workerIdx, Task&& task);
+
+    /**
+        Run all pushed tasks, including the ones pushed while running, to completion. Blocks until done.
+    */
+    void runAll();
+
+    /**
+        Get the number of workers, including the calling thread.
+
+        @return Number of workers
+    */
+    int32_t getWorkerCount() const;
+
+private:
+    /* Cannot be copied or moved */
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool(WorkStealingPool&&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(WorkStealingPool&&) = delete;
+
+    struct WorkerQueue
+    {
+        std::mutex mtx;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(const int32_t workerIdx);
+    void drain(const int32_t workerIdx);
+    bool popOrSteal(const int32_t workerIdx, Task& outTask);
+    void waitForTasks();
+
+private:
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> threads_;
+    std::atomic<int64_t> pendingTasks_{0};
+    std::atomic<int64_t> queuedTasks_{0};
+    std::atomic<int32_t> idleWorkers_{0};
+    std::mutex idleMtx_;
+    std::condition_variable idleCv_;
+    std::mutex wakeMtx_;
+    std::condition_variable wakeCv_;
+    uint64_t generation_{0};
+    bool isStopping_{false};
+};
+} // namespace msgui::layoutengine::utils
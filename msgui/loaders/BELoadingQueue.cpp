@@ -33,6 +33,23 @@ void BELoadingQueue::executeTasks()
         }
         fontTasks_.pop();
     }
+
+    /* Void tasks may push new tasks while running, those wait for the next loop. */
+    std::queue<VoidTask> voidTasks;
+    {
+        std::unique_lock lock{mtx_};
+        std::swap(voidTasks, voidTasks_);
+    }
+    while (!voidTasks.empty())
+    {
+        auto& task = voidTasks.front();
+        if (task.valid())
+        {
+            task();
+            task.reset();
+        }
+        voidTasks.pop();
+    }
 }
 
 void BELoadingQueue::pushTask(UIntTask&& task)
@@ -53,6 +70,15 @@ void BELoadingQueue::pushTask(FontTask&& task)
     Window::requestEmptyEvent();
 }
 
+void BELoadingQueue::pushTask(VoidTask&& task)
+{
+    std::unique_lock lock{mtx_};
+    voidTasks_.emplace(std::move(task));
+
+    /* We need to notify main thread to run it's UI loop */
+    Window::requestEmptyEvent();
+}
+
 bool BELoadingQueue::isThisMainThread()
 {
     return mainThreadId_ == std::hash<std::thread::id>{}(std::this_thread::get_id());
@@ -14,6 +14,7 @@ namespace msgui::loaders
 
 using UIntTask = std::packaged_task<uint32_t()>;
 using FontTask = std::packaged_task<FontPtr()>;
+using VoidTask = std::packaged_task<void()>;
 
 /* Class used to load backend resources from the main thread when loading was requested
    from secondary threads.
@@ -49,6 +50,13 @@ public:
     */
     void pushTask(FontTask&& task);
 
+    /**
+        Push task that doesn't return anything. Used by workers to hand their results over to the UI thread.
+
+        @param task Task function to be executed
+    */
+    void pushTask(VoidTask&& task);
+
     /**
         Check if the calling thread is the main UI one.
 
@@ -67,6 +75,7 @@ private:
     uint64_t mainThreadId_{std::hash<std::thread::id>{}(std::this_thread::get_id())};
     std::queue<UIntTask> uintTasks_;  // TODO: Ideally we shall have a single queue
     std::queue<FontTask> fontTasks_;
+    std::queue<VoidTask> voidTasks_;
     std::mutex mtx_;
 };
 } // namespace msgui::loaders
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "msgui/loaders/FontLoader.hpp"
 
+#include <algorithm>
 #include <future>
 #include <unordered_map>
 #include <memory>
@@ -8,9 +9,11 @@
 #include <GL/glew.h>
 #include <ft2build.h>
 #include FT_FREETYPE_H
+#include FT_MODULE_H
 
 #include "msgui/loaders/BELoadingQueue.hpp"
 #include "msgui/Logger.hpp"
+#include "msgui/renderer/GlyphAtlas.hpp"
 #include "msgui/renderer/Types.hpp"
 #include "msgui/vendor/stb_image_write.h"
 
@@ -29,26 +32,73 @@ FontLoader::FontLoader()
     if (FT_Init_FreeType(&ftLib_))
     {
         log_.errorLn("FreeType lib failed to load!");
+        return;
     }
+
+    /* Spread is in pixels of the reference size, shaders rely on it staying the same for every glyph. */
+    const FT_Int spread = SDF_SPREAD;
+    FT_Property_Set(ftLib_, "sdf", "spread", &spread);
 }
 
 FontLoader::~FontLoader()
 {
+    for (auto& [font, ftFace] : fontFaces_) { FT_Done_Face(ftFace); }
     FT_Done_FreeType(ftLib_);
     log_.debugLn("Deallocated.");
 }
 
 FontPtr FontLoader::loadFont(const std::string& fontPath, const int32_t fontSize)
 {
-    std::string fontKey = fontPath + std::to_string(fontSize);
+    if (sdfMode_) { return loadSdfFont(fontPath, fontSize); }
+
+    return loadFontCached(fontPath + std::to_string(fontSize), fontPath, fontSize, false);
+}
+
+void FontLoader::setSdfMode(const bool value) { sdfMode_ = value; }
+
+bool FontLoader::isSdfMode() const { return sdfMode_; }
+
+FontPtr FontLoader::loadSdfFont(const std::string& fontPath, const int32_t fontSize)
+{
+    std::string fontKey = fontPath + "sdf" + std::to_string(fontSize);
+    if (fontPathToObject_.count(fontKey))
+    {
+        return fontPathToObject_.at(fontKey);
+    }
+
+    FontPtr font = std::make_shared<Font>();
+    font->fontSize = fontSize;
+    font->fontPath = fontPath;
+    font->isSdf = true;
+
+    if (fontSize < MIN_FONT_SIZE || fontSize > MAX_FONT_SIZE)
+    {
+        log_.errorLn("Failed to load font: \"%s\". Size is out of bounds: %d. Will keep previous font size.",
+            fontPath.c_str(), fontSize);
+        return font;
+    }
+
+    /* Glyphs get rasterized only once, at the reference size. Any other size is just a scale factor on top. */
+    font->glyphSource = loadFontCached(fontPath + "sdf", fontPath, SDF_REFERENCE_SIZE, true);
+    font->scale = (float)fontSize / SDF_REFERENCE_SIZE;
+    font->isLoaded = font->glyphSource->isLoaded;
+
+    fontPathToObject_[fontKey] = font;
+
+    return font;
+}
+
+FontPtr FontLoader::loadFontCached(const std::string& fontKey, const std::string& fontPath, const int32_t fontSize,
+    const bool isSdf)
+{
     if (fontPathToObject_.count(fontKey))
     {
         return fontPathToObject_.at(fontKey);
     }
 
-    std::packaged_task<FontPtr()> task([this, fontPath, fontSize]()
+    std::packaged_task<FontPtr()> task([this, fontPath, fontSize, isSdf]()
     {
-        return loadFontInternal(fontPath, fontSize);
+        return loadFontInternal(fontPath, fontSize, isSdf);
     });
 
     auto futureTask = task.get_future();
@@ -62,11 +112,12 @@ FontPtr FontLoader::loadFont(const std::string& fontPath, const int32_t fontSize
     return fontPathToObject_.at(fontKey);
 }
 
-FontPtr FontLoader::loadFontInternal(const std::string& fontPath, const int32_t fontSize)
+FontPtr FontLoader::loadFontInternal(const std::string& fontPath, const int32_t fontSize, const bool isSdf)
 {
     FontPtr font = std::make_shared<Font>();
     font->fontSize = fontSize;
     font->fontPath = fontPath;
+    font->isSdf = isSdf;
 
     if (fontSize < MIN_FONT_SIZE || fontSize > MAX_FONT_SIZE)
     {
@@ -84,60 +135,149 @@ FontPtr FontLoader::loadFontInternal(const std::string& fontPath, const int32_t
 
     FT_Set_Pixel_Sizes(ftFace, fontSize, fontSize);
 
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    /* All fonts and sizes share the same atlas, glyphs only take as much space as their bitmap needs. */
+    renderer::GlyphAtlas& atlas = renderer::GlyphAtlas::get();
+
+    /* Only the low range is loaded upfront, the rest gets rasterized on demand. */
+    for (int32_t i = 32; i < MAX_CODEPOINTS; i++)
+    {
+        rasterizeCodePoint(ftFace, i, isSdf, font->codePointData[i]);
+    }
+
+    font->isLoaded = true;
+    log_.infoLn("Loaded %sfont with size %d from \"%s\"", isSdf ? "SDF " : "", fontSize, fontPath.c_str());
+    atlas.reportOccupancy();
+
+    /* Face is kept around until the loader dies as codepoints can be requested at any time. */
+    fontFaces_[font.get()] = ftFace;
+
+    return font;
+}
+
+const Font::CodePointData& FontLoader::getCodePoint(Font& font, const uint32_t codePoint)
+{
+    /* Scaled SDF fonts share the glyphs of their source, metrics get scaled by the caller. */
+    if (font.glyphSource) { return getCodePoint(*font.glyphSource, codePoint); }
+
+    if (codePoint < MAX_CODEPOINTS) { return font.codePointData[codePoint]; }
+
+    const auto it = font.lazyCodePointData.find(codePoint);
+    if (it == font.lazyCodePointData.end()) { return loadLazyCodePoint(font, codePoint); }
+
+    /* Mark as most recently used. */
+    it->second.lruIt->lastUsedPass = currentPass_;
+    lru_.splice(lru_.begin(), lru_, it->second.lruIt);
 
-    glGenTextures(1, &font->texId);
+    return it->second.data;
+}
 
-    if (!font->texId)
+uint64_t FontLoader::beginGlyphPass()
+{
+    currentPass_++;
+    return evictionCount_;
+}
+
+void FontLoader::setGlyphCacheBudget(const int64_t budget)
+{
+    glyphCacheBudget_ = std::max(budget, (int64_t)0);
+}
+
+uint64_t FontLoader::getEvictionCount() const { return evictionCount_; }
+
+int64_t FontLoader::getGlyphCacheUsage() const { return glyphCacheUsage_; }
+
+const Font::CodePointData& FontLoader::loadLazyCodePoint(Font& font, const uint32_t codePoint)
+{
+    const auto faceIt = fontFaces_.find(&font);
+    if (faceIt == fontFaces_.end()) { return emptyCodePoint_; }
+
+    FT_Face ftFace = faceIt->second;
+
+    /* Only get the metrics first, evicted glyphs need to make room in the atlas before this one gets packed. */
+    if (FT_Load_Char(ftFace, codePoint, FT_LOAD_DEFAULT))
     {
-        log_.warnLn(
-            "No failures but font texture id is zero. Are you loading incorrectly from another openGL context?");
-        return font;
+        log_.errorLn("Error loading char code: %u", codePoint);
+        return emptyCodePoint_;
+    }
+
+    /* SDF bitmaps get the spread added on each side. */
+    const int64_t border = font.isSdf ? SDF_SPREAD * 2 : 0;
+    const int64_t bytes = ((int64_t)ftFace->glyph->metrics.width / 64 + border)
+        * ((int64_t)ftFace->glyph->metrics.height / 64 + border) + sizeof(Font::LazyCodePointData);
+    if (!evictUntilFits(bytes) && overBudgetWarnPass_ != currentPass_)
+    {
+        overBudgetWarnPass_ = currentPass_;
+        log_.warnLn("Glyph cache budget of %ld bytes is too small for the glyphs currently in use", glyphCacheBudget_);
     }
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D_ARRAY, font->texId);
+    Font::CodePointData data;
+    if (!rasterizeCodePoint(ftFace, codePoint, font.isSdf, data)) { return emptyCodePoint_; }
 
-    /* Generate MAX_CODEPOINTS levels deep texture. */
-    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RED, fontSize, fontSize, MAX_CODEPOINTS, 0, GL_RED, GL_UNSIGNED_BYTE, nullptr);
+    lru_.push_front(LazyGlyphRef{
+        .font = &font,
+        .codePoint = codePoint,
+        .bytes = bytes,
+        .lastUsedPass = currentPass_});
+    glyphCacheUsage_ += bytes;
 
-    /* Wrapping, mag & min settings. */
-    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    auto& entry = font.lazyCodePointData[codePoint];
+    entry.data = data;
+    entry.lruIt = lru_.begin();
 
-    FT_Int32 load_flags = FT_LOAD_RENDER;
-    for (int32_t i = 32; i < MAX_CODEPOINTS; i++)
+    return entry.data;
+}
+
+bool FontLoader::rasterizeCodePoint(FT_Face ftFace, const uint32_t codePoint, const bool isSdf,
+    Font::CodePointData& outData)
+{
+    if (FT_Load_Char(ftFace, codePoint, isSdf ? FT_LOAD_DEFAULT : FT_LOAD_RENDER))
     {
-        /* Loads i'th char in font atlas */
-        if (FT_Load_Char(ftFace, i, load_flags))
-        {
-            log_.errorLn("Error loading char code: %d", i);
-            continue;
-        }
-
-        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, i, ftFace->glyph->bitmap.width, ftFace->glyph->bitmap.rows, 1,
-            GL_RED, GL_UNSIGNED_BYTE, ftFace->glyph->bitmap.buffer);
-
-        Font::CodePointData ch =
-        {
-            .charCode = uint32_t(i),
-            .hAdvance = ftFace->glyph->advance.x,
-            .size = glm::ivec2(ftFace->glyph->bitmap_left + ftFace->glyph->bitmap.width,
-                ftFace->glyph->bitmap_top + ftFace->glyph->bitmap.rows),
-            .bearing = glm::ivec2(ftFace->glyph->bitmap_left, ftFace->glyph->bitmap_top)
-        };
-
-        font->codePointData[i] = ch;
+        log_.errorLn("Error loading char code: %u", codePoint);
+        return false;
     }
 
-    log_.infoLn("Loaded font texture {%d} with size %d from \"%s\"", font->texId, fontSize, fontPath.c_str());
+    /* Distance field gets rendered from the outline, bitmap gets padded with the spread on each side. */
+    if (isSdf && FT_Render_Glyph(ftFace->glyph, FT_RENDER_MODE_SDF))
+    {
+        log_.errorLn("Error rendering SDF for char code: %u", codePoint);
+        return false;
+    }
 
-    /* Unbind texture and free FreeType resources */
-    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
-    FT_Done_Face(ftFace);
+    glm::ivec4 uvRect;
+    const uint32_t atlasSlot = renderer::GlyphAtlas::get().addGlyph(
+        glm::ivec2(ftFace->glyph->bitmap.width, ftFace->glyph->bitmap.rows), ftFace->glyph->bitmap.buffer, uvRect);
 
-    return font;
+    outData =
+    {
+        .charCode = codePoint,
+        .hAdvance = ftFace->glyph->advance.x,
+        .size = glm::ivec2(ftFace->glyph->bitmap_left + ftFace->glyph->bitmap.width,
+            ftFace->glyph->bitmap_top + ftFace->glyph->bitmap.rows),
+        .bearing = glm::ivec2(ftFace->glyph->bitmap_left, ftFace->glyph->bitmap_top),
+        .atlasSlot = atlasSlot,
+        .uvRect = uvRect
+    };
+
+    return true;
+}
+
+bool FontLoader::evictUntilFits(const int64_t bytes)
+{
+    while (glyphCacheUsage_ + bytes > glyphCacheBudget_ && !lru_.empty())
+    {
+        /* Glyphs used in the current pass might already be laid out, they can't go. */
+        LazyGlyphRef& victim = lru_.back();
+        if (victim.lastUsedPass == currentPass_) { return false; }
+
+        const auto it = victim.font->lazyCodePointData.find(victim.codePoint);
+        renderer::GlyphAtlas::get().removeGlyph(it->second.data.atlasSlot);
+        victim.font->lazyCodePointData.erase(it);
+
+        glyphCacheUsage_ -= victim.bytes;
+        evictionCount_++;
+        lru_.pop_back();
+    }
+
+    return glyphCacheUsage_ + bytes <= glyphCacheBudget_;
 }
 } // namespace msgui::loaders
\ No newline at end of file
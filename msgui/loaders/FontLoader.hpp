@@ -23,11 +23,59 @@ public:
 
     FontPtr loadFont(const std::string& fontPath, const int32_t fontSize = DEFAULT_FONT_SIZE);
 
+    /**
+        Enable or disable signed distance field fonts for fonts loaded from now on. SDF glyphs are rasterized once
+        at a reference size and shared by every font size of the same face, only the scale differs.
+
+        @param value True to load SDF fonts
+    */
+    void setSdfMode(const bool value);
+    bool isSdfMode() const;
+
+    /**
+        Get metrics & atlas placement of a codepoint. Codepoints outside of the eagerly loaded range get rasterized
+        on first use and may evict the least recently used lazy glyphs to stay under the cache budget.
+
+        @note Must be called from the GL thread as it may upload into the glyph atlas.
+
+        @param font Font to get the codepoint from
+        @param codePoint Unicode codepoint
+
+        @return Codepoint data. Only valid until the next lookup of a lazy codepoint
+    */
+    const Font::CodePointData& getCodePoint(Font& font, const uint32_t codePoint);
+
+    /**
+        Start a new glyph use pass. Glyphs looked up during the current pass are never evicted, so anything laid out
+        in it stays valid until the next pass.
+
+        @return Eviction count at the start of the pass
+    */
+    uint64_t beginGlyphPass();
+
+    /**
+        Set how many bytes of lazily rasterized glyph bitmaps can be kept in the atlas.
+
+        @param budget Budget in bytes
+    */
+    void setGlyphCacheBudget(const int64_t budget);
+
+    /* Trivial getters */
+    uint64_t getEvictionCount() const;
+    int64_t getGlyphCacheUsage() const;
+
 private:
     FontLoader();
     ~FontLoader();
 
-    FontPtr loadFontInternal(const std::string& fontPath, const int32_t fontSize);
+    FontPtr loadSdfFont(const std::string& fontPath, const int32_t fontSize);
+    FontPtr loadFontCached(const std::string& fontKey, const std::string& fontPath, const int32_t fontSize,
+        const bool isSdf);
+    FontPtr loadFontInternal(const std::string& fontPath, const int32_t fontSize, const bool isSdf);
+    const Font::CodePointData& loadLazyCodePoint(Font& font, const uint32_t codePoint);
+    bool rasterizeCodePoint(FT_Face ftFace, const uint32_t codePoint, const bool isSdf,
+        Font::CodePointData& outData);
+    bool evictUntilFits(const int64_t bytes);
 
     /* Cannot be copied or moved */
     FontLoader(const FontLoader&) = delete;
@@ -38,7 +86,20 @@ private:
 private:
     Logger log_{"FontLoader"};
     FT_Library ftLib_;
+    bool sdfMode_{false};
+
+    /* Faces need to stay open for lazy rasterization. */
+    std::unordered_map<const Font*, FT_Face> fontFaces_;
+    LazyGlyphList lru_;
+    int64_t glyphCacheBudget_{DEFAULT_GLYPH_CACHE_BUDGET};
+    int64_t glyphCacheUsage_{0};
+    uint64_t currentPass_{0};
+    uint64_t evictionCount_{0};
+    uint64_t overBudgetWarnPass_{0};
+    Font::CodePointData emptyCodePoint_{};
 
     static std::unordered_map<std::string, FontPtr> fontPathToObject_;
+
+    static constexpr int64_t DEFAULT_GLYPH_CACHE_BUDGET{4 * 1024 * 1024};
 };
 } // namespace msgui::loaders
\ No newline at end of file
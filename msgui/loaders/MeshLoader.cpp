@@ -23,18 +23,23 @@ MeshLoader::~MeshLoader()
 
 Mesh* MeshLoader::loadQuad()
 {
-    if (meshPathToObject_.count(INTERNAL_QUAD_KEY))
+    return loadQuad(INTERNAL_QUAD_KEY);
+}
+
+Mesh* MeshLoader::loadQuad(const std::string& meshKey)
+{
+    if (meshPathToObject_.count(meshKey))
     {
-        return meshPathToObject_.at(INTERNAL_QUAD_KEY);
+        return meshPathToObject_.at(meshKey);
     }
 
-    log_ = Logger("MeshLoader(Quad)");
+    log_ = Logger("MeshLoader(" + meshKey + ")");
 
     Mesh* meshPtr = new Mesh(get().loadInternalQuad());
-    meshPathToObject_[INTERNAL_QUAD_KEY] = meshPtr;
+    meshPathToObject_[meshKey] = meshPtr;
 
     log_.infoLn("Loaded!");
-    return meshPathToObject_.at(INTERNAL_QUAD_KEY);
+    return meshPathToObject_.at(meshKey);
 }
 
 Mesh MeshLoader::loadInternalQuad()
@@ -33,6 +33,16 @@ public:
     */
     static Mesh* loadQuad();
 
+    /**
+        Load a quad mesh that has it's own vertex array object stored under a custom key. Useful for renderers
+        that need to attach extra (instanced) attributes to the quad without affecting the shared one.
+
+        @param meshKey Unique key under which the quad will be stored
+
+        @return Mesh pointer
+    */
+    static Mesh* loadQuad(const std::string& meshKey);
+
 private:
     /* Cannot be copied or moved */
     MeshLoader() = default;
@@ -1,9 +1,11 @@
 #include "ShaderLoader.hpp"
 
 #include <cstdint>
+#include <filesystem>
 #include <fstream>
 #include <future>
 #include <sstream>
+#include <vector>
 
 #include <GLFW/glfw3.h>
 
@@ -11,8 +13,37 @@
 
 namespace msgui::loaders
 {
+namespace
+{
+/* FNV-1a, stable between runs unlike std::hash. */
+uint64_t hashString(const std::string& data)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (const char c : data)
+    {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+/* Header fields are read & written one by one, the struct's padding would otherwise end up in the file. */
+template<typename T>
+void writeField(std::ofstream& file, const T& value)
+{
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+void readField(std::ifstream& file, T& value)
+{
+    file.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+} // namespace
+
 Logger ShaderLoader::log_ = {"ShaderLoader(null)"};
 std::unordered_map<std::string, Shader*> ShaderLoader::shaderPathToObject_ = {};
+std::string ShaderLoader::binaryCacheDir_ = {};
 
 ShaderLoader::~ShaderLoader()
 {
@@ -33,7 +64,9 @@ Shader* ShaderLoader::loadShader(const std::string& shaderPath)
     }
     log_ = Logger("ShaderLoader(" + shaderPath + ")");
 
-    Shader* shaderPtr = new Shader(get().loadInternal(shaderPath), shaderPath);
+    Shader::UniformTable uniforms;
+    const uint32_t shaderId = get().loadInternal(shaderPath, uniforms);
+    Shader* shaderPtr = new Shader(shaderId, std::move(uniforms), shaderPath);
     shaderPathToObject_[shaderPath] = shaderPtr;
 
     if (shaderPtr->getShaderId() != 0)
@@ -59,9 +92,10 @@ void ShaderLoader::reload(const std::string& shaderPath)
     }
 
     // TODO: Previous shader needs to be deleted, consumes memory.
-    if (uint32_t shaderId = get().loadInternal(shaderPath); shaderId != 0)
+    Shader::UniformTable uniforms;
+    if (uint32_t shaderId = get().loadInternal(shaderPath, uniforms); shaderId != 0)
     {
-        *shaderPathToObject_[shaderPath] = Shader(get().loadInternal(shaderPath), shaderPath);
+        *shaderPathToObject_[shaderPath] = Shader(shaderId, std::move(uniforms), shaderPath);
         log_.infoLn("Reloaded %d!",  shaderPathToObject_[shaderPath]->getShaderId());
     }
     else
@@ -70,9 +104,15 @@ void ShaderLoader::reload(const std::string& shaderPath)
     }
 }
 
-uint32_t ShaderLoader::loadInternal(const std::string& shaderPath)
+void ShaderLoader::setBinaryCacheDir(const std::string& dirPath)
 {
-    std::packaged_task<uint32_t()> task([shaderPath]() -> uint32_t
+    binaryCacheDir_ = dirPath;
+}
+
+uint32_t ShaderLoader::loadInternal(const std::string& shaderPath, Shader::UniformTable& outUniforms)
+{
+    /* Caller waits for the task, so the out table is still there when the task fills it. */
+    std::packaged_task<uint32_t()> task([shaderPath, &outUniforms]() -> uint32_t
     {
         ShaderLoader& instance = get();
 
@@ -88,6 +128,14 @@ uint32_t ShaderLoader::loadInternal(const std::string& shaderPath)
         std::string content = stream.str();
         shaderFile.close();
 
+        /* Skip compiling & linking altogether if the driver already gave us this exact program before. */
+        const uint64_t cacheKey = instance.computeCacheKey(content);
+        if (uint32_t cachedShaderId = instance.loadFromBinaryCache(shaderPath, cacheKey))
+        {
+            outUniforms = Shader::resolveUniforms(cachedShaderId);
+            return cachedShaderId;
+        }
+
         const size_t fragCutoff = content.find("/// frag ///\n"); /* WRN: LF ending handled only */
         if (fragCutoff == std::string::npos)
         {
@@ -99,6 +147,8 @@ uint32_t ShaderLoader::loadInternal(const std::string& shaderPath)
         std::string fragData{content.begin() + fragCutoff, content.end()};
 
         uint32_t shaderId = instance.loadInternal(vertData, fragData);
+        instance.storeToBinaryCache(shaderPath, cacheKey, shaderId);
+        outUniforms = Shader::resolveUniforms(shaderId);
         return shaderId;
     });
 
@@ -128,6 +178,10 @@ uint32_t ShaderLoader::linkShaders(int vertShaderId, int fragShaderId)
 
     glAttachShader(shaderId, vertShaderId);
     glAttachShader(shaderId, fragShaderId);
+    if (!binaryCacheDir_.empty())
+    {
+        glProgramParameteri(shaderId, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
     glLinkProgram(shaderId);
 
     int success;
@@ -168,6 +222,113 @@ uint32_t ShaderLoader::compileShaderData(const std::string& data, const ShaderPa
     return shaderPart;
 }
 
+uint64_t ShaderLoader::computeCacheKey(const std::string& shaderSource)
+{
+    if (binaryCacheDir_.empty()) { return 0; }
+
+    /* Binaries are only valid for the exact driver that produced them. */
+    const auto glString = [](const uint32_t name) -> std::string
+    {
+        const char* value = reinterpret_cast<const char*>(glGetString(name));
+        return value ? value : "";
+    };
+    const std::string keyData = shaderSource + '\0' + glString(GL_VENDOR) + '\0' + glString(GL_RENDERER)
+        + '\0' + glString(GL_VERSION);
+
+    return hashString(keyData);
+}
+
+std::string ShaderLoader::getBinaryCachePath(const std::string& shaderPath)
+{
+    /* Shaders with the same file name can live in different directories, the full path keeps their binaries apart.
+       File name is still kept around to make the cache dir readable. */
+    std::error_code ec;
+    std::filesystem::path fullPath = std::filesystem::weakly_canonical(shaderPath, ec);
+    if (ec) { fullPath = shaderPath; }
+
+    std::stringstream fileName;
+    fileName << std::filesystem::path(shaderPath).filename().string() << '-' << std::hex
+        << hashString(fullPath.string()) << ".bin";
+    return (std::filesystem::path(binaryCacheDir_) / fileName.str()).string();
+}
+
+uint32_t ShaderLoader::loadFromBinaryCache(const std::string& shaderPath, const uint64_t cacheKey)
+{
+    if (binaryCacheDir_.empty()) { return 0; }
+
+    std::ifstream cacheFile(getBinaryCachePath(shaderPath), std::ios::binary);
+    if (!cacheFile) { return 0; }
+
+    BinaryCacheHeader header;
+    readField(cacheFile, header.magic);
+    readField(cacheFile, header.cacheKey);
+    readField(cacheFile, header.format);
+    readField(cacheFile, header.length);
+    if (!cacheFile || header.magic != BINARY_CACHE_MAGIC || header.cacheKey != cacheKey || header.length <= 0)
+    {
+        log_.infoLn("Binary cache outdated, compiling from source.");
+        return 0;
+    }
+
+    std::vector<char> binary(header.length);
+    cacheFile.read(binary.data(), header.length);
+    if (!cacheFile)
+    {
+        log_.warnLn("Binary cache truncated, compiling from source.");
+        return 0;
+    }
+
+    uint32_t shaderId = glCreateProgram();
+    glProgramBinary(shaderId, header.format, binary.data(), header.length);
+
+    /* Driver is free to reject binaries for any reason, just fallback to compiling in that case. */
+    int32_t success = 0;
+    glGetProgramiv(shaderId, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        log_.warnLn("Binary cache rejected by driver, compiling from source.");
+        glDeleteProgram(shaderId);
+        return 0;
+    }
+
+    log_.infoLn("Loaded from binary cache.");
+    return shaderId;
+}
+
+void ShaderLoader::storeToBinaryCache(const std::string& shaderPath, const uint64_t cacheKey,
+    const uint32_t shaderId)
+{
+    if (binaryCacheDir_.empty() || shaderId == 0) { return; }
+
+    int32_t formatsCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatsCount);
+    if (formatsCount <= 0) { return; }
+
+    BinaryCacheHeader header{.cacheKey = cacheKey};
+    glGetProgramiv(shaderId, GL_PROGRAM_BINARY_LENGTH, &header.length);
+    if (header.length <= 0) { return; }
+
+    std::vector<char> binary(header.length);
+    glGetProgramBinary(shaderId, header.length, nullptr, &header.format, binary.data());
+
+    std::error_code ec;
+    std::filesystem::create_directories(binaryCacheDir_, ec);
+
+    const std::string cachePath = getBinaryCachePath(shaderPath);
+    std::ofstream cacheFile(cachePath, std::ios::binary | std::ios::trunc);
+    if (!cacheFile)
+    {
+        log_.warnLn("Could not write binary cache to %s", cachePath.c_str());
+        return;
+    }
+
+    writeField(cacheFile, header.magic);
+    writeField(cacheFile, header.cacheKey);
+    writeField(cacheFile, header.format);
+    writeField(cacheFile, header.length);
+    cacheFile.write(binary.data(), header.length);
+}
+
 ShaderLoader& ShaderLoader::get()
 {
     static ShaderLoader instance = ShaderLoader();
@@ -34,6 +34,14 @@ public:
     */
     static void reload(const std::string& shaderPath);
 
+    /**
+        Enable caching of linked program binaries on disk. Cached binaries are reused on later launches as long
+        as the shader source and the GL driver didn't change, otherwise the shader is compiled from source again.
+
+        @param dirPath Directory to store the binaries into. Empty path disables the cache (default)
+    */
+    static void setBinaryCacheDir(const std::string& dirPath);
+
 private:
     /* Cannot be copied or moved */
     ShaderLoader() = default;
@@ -43,15 +51,31 @@ private:
     ShaderLoader& operator=(const ShaderLoader&);
     ShaderLoader& operator=(ShaderLoader&&);
 
-    uint32_t loadInternal(const std::string& shaderPath);
+    uint32_t loadInternal(const std::string& shaderPath, Shader::UniformTable& outUniforms);
     uint32_t loadInternal(const std::string& vertCode, const std::string& fragCode);
     uint32_t linkShaders(int vertShaderId, int fragShaderId);
     uint32_t compileShaderData(const std::string& data, const ShaderPartType shaderType);
+    uint64_t computeCacheKey(const std::string& shaderSource);
+    std::string getBinaryCachePath(const std::string& shaderPath);
+    uint32_t loadFromBinaryCache(const std::string& shaderPath, const uint64_t cacheKey);
+    void storeToBinaryCache(const std::string& shaderPath, const uint64_t cacheKey, const uint32_t shaderId);
 
     static ShaderLoader& get();
 
 private:
+    /* Header placed in front of each cached program binary. */
+    struct BinaryCacheHeader
+    {
+        uint32_t magic{BINARY_CACHE_MAGIC};
+        uint64_t cacheKey{0};
+        uint32_t format{0};
+        int32_t length{0};
+    };
+
     static Logger log_;
     static std::unordered_map<std::string, Shader*> shaderPathToObject_;
+    static std::string binaryCacheDir_;
+
+    static constexpr uint32_t BINARY_CACHE_MAGIC{0x4D534742}; // "MSGB"
 };
 } // namespace msgui::loaders
\ No newline at end of file
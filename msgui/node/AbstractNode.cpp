@@ -9,12 +9,18 @@ namespace msgui
 {
 AbstractNode::AbstractNode(const std::string& name, const NodeType nodeType)
         : id_(genetateNextId())
+        , handle_(NodeRegistry::get().acquire(this))
         , name_(name)
         , nodeType_(nodeType)
 {
     setupReloadables();
 }
 
+AbstractNode::~AbstractNode()
+{
+    NodeRegistry::get().release(handle_);
+}
+
 void AbstractNode::appendAt(const std::shared_ptr<AbstractNode>& node, const int32_t idx)
 {
     if (!node)
@@ -32,14 +38,19 @@ void AbstractNode::appendAt(const std::shared_ptr<AbstractNode>& node, const int
     /* isParented_ is used as a quick mean to check even before all the layout "stabilization" if this node has been
        parented already so that we can avoid "double parenting" to yet another node.
        Only when the layout will be calculated again (next frame) will the parentNode & state be
-       populated accordingly if absent. */
+       populated accordingly if absent. Raw parent is known right away so the frame can tell later on if the node
+       is still attached here. */
     node->isParented_ = true;
+    node->parentRaw_ = this;
 
     children_.insert(children_.begin() + idx, node);
     if (state_)
     {
-        state_->layoutPassActions |= ELayoutPass::EVERYTHING_NODE;
+        /* Frame only needs to attach the subtree starting from here. */
+        state_->attachedNodes.push_back(node);
+        state_->layoutPassActions |= ELayoutPass::RESOLVE_NODE_RELATIONS;
     }
+    markLayoutDirty();
 }
 
 void AbstractNode::append(const std::shared_ptr<AbstractNode>& node)
@@ -197,6 +208,53 @@ AbstractNodePtr AbstractNode::findOneBy(const std::function<bool(AbstractNodePtr
     return *it;
 }
 
+bool AbstractNode::setInstanceAttributes(renderer::RectInstanceData&)
+{
+    /* Nodes are not batchable unless they say so. */
+    return false;
+}
+
+bool AbstractNode::fillRectInstance(renderer::RectInstanceData& data, const glm::vec4& color,
+    const glm::vec4& borderColor) const
+{
+    data.color = color;
+    data.borderColor = borderColor;
+    data.borderSize = layout_.border;
+    data.borderRadii = layout_.borderRadius;
+    return true;
+}
+
+void AbstractNode::markLayoutDirty()
+{
+    isLayoutDirty_ = true;
+    isFitScaleValid_ = false;
+
+    /* Scale of FIT parents depends on their subNodes, so their own parent needs to place them again. The same
+       goes for their FIT measurement. */
+    AbstractNode* node = this;
+    while (AbstractNode* parent = node->parentRaw_)
+    {
+        parent->isLayoutDirty_ = true;
+        parent->isFitScaleValid_ = false;
+
+        const utils::Layout::ScaleXY& parentScale = parent->layout_.newScale;
+        if (parentScale.x.type != utils::Layout::ScaleType::FIT
+            && parentScale.y.type != utils::Layout::ScaleType::FIT) { break; }
+        node = parent;
+    }
+
+    /* Leave a trail for the frame to find this node, all the way up as a failed pass can leave partial trails. */
+    for (AbstractNode* parent = parentRaw_; parent; parent = parent->parentRaw_)
+    {
+        parent->hasDirtySubNodes_ = true;
+    }
+
+    if (state_)
+    {
+        state_->layoutPassActions |= ELayoutPass::RECALCULATE_NODE_TRANSFORM;
+    }
+}
+
 void AbstractNode::printTree(uint32_t currentDepth)
 {
     /*
@@ -298,6 +356,11 @@ uint32_t AbstractNode::getId() const
     return id_;
 }
 
+NodeHandle AbstractNode::getHandle() const
+{
+    return handle_;
+}
+
 AbstractNode::NodeType AbstractNode::getType() const
 {
     return nodeType_;
@@ -352,8 +415,14 @@ void AbstractNode::resetStatesRecursively(AbstractNodePtr& node)
         1. There's no more state to rely on, you're detached from the main UI tree
         2. You can no longer be visible so your vScale needs to be reset
     */
+    /* Frame still has this one in its viewable area pass until node relations get resolved again. */
+    if (node->state_) { node->state_->detachedSlots.push_back(node->transform_.slot); }
     node->state_ = nullptr;
     node->transform_.vScale = {0, 0};
+    node->isLayoutDirty_ = true;
+    node->hasDirtySubNodes_ = true;
+    node->laidOutPos_ = glm::vec3{-1};
+    node->laidOutScale_ = glm::vec3{-1};
     for (auto& ch : node->getChildren())
     {
         resetStatesRecursively(ch);
@@ -376,5 +445,13 @@ void AbstractNode::setupReloadables()
     layout_.onScaleChange = updateCb;
     layout_.onMinScaleChange = updateCb;
     layout_.onMaxScaleChange = updateCb;
+
+    /* Only the dirty parts of the tree get laid out again, so everything affecting layout needs to notify. */
+    layout_.onNewScaleChange = updateCb;
+    layout_.onTypeChange = updateCb;
+    layout_.onAlignChildChange = updateCb;
+    layout_.onSpacingChange = updateCb;
+    layout_.onAllowWrapChange = updateCb;
+    layout_.onGridDistribChange = updateCb;
 }
 } // namespace msgui
\ No newline at end of file
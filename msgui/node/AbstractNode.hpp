@@ -9,8 +9,10 @@
 #include "msgui/Shader.hpp"
 #include "msgui/Mesh.hpp"
 #include "msgui/node/FrameState.hpp"
+#include "msgui/node/NodeRegistry.hpp"
 #include "msgui/events/NodeEventManager.hpp"
 #include "msgui/layoutEngine/utils/Transform.hpp"
+#include "msgui/renderer/Types.hpp"
 #include "msgui/Utils.hpp"
 
 namespace msgui
@@ -32,6 +34,7 @@ using namespace layoutengine;
     using AbstractNode::findOneBy;\
 
 class WindowFrame;
+class CustomLayoutEngine;
 class AbstractNode;
 using AbstractNodePtr = std::shared_ptr<AbstractNode>;
 using AbstractNodePVec = std::vector<AbstractNodePtr>;
@@ -61,7 +64,7 @@ public:
 
 public:
     explicit AbstractNode(const std::string& name, const NodeType nodeType = NodeType::COMMON);
-    virtual ~AbstractNode() = default;
+    virtual ~AbstractNode();
 
 protected:
     /**
@@ -191,12 +194,34 @@ protected:
         return Utils::as<T>(findOneBy(pred));
     }
 
+    /**
+        Fill in the instance attributes shared by all batchable nodes. Meant for setInstanceAttributes overrides.
+
+        @param data Instance data to be filled
+        @param color Fill color of the node
+        @param borderColor Border color of the node
+
+        @return Always true, the node can be batch rendered
+    */
+    bool fillRectInstance(renderer::RectInstanceData& data, const glm::vec4& color,
+        const glm::vec4& borderColor) const;
+
 public:
     /**
         Each node can have it's own shader attributes and this function allows to set them per node.
     */
     virtual void setShaderAttributes() = 0;
 
+    /**
+        Nodes drawn with the sdfRect shader can be rendered in batches. Such nodes shall fill in their per
+        instance attributes and return true. Position, scale and clipping are filled in by the renderer itself.
+
+        @param data Instance data to be filled
+
+        @return True if the node can be batch rendered, False otherwise
+    */
+    virtual bool setInstanceAttributes(renderer::RectInstanceData& data);
+
     /**
         Prints a tree view of the current's node children.
 
@@ -204,6 +229,13 @@ public:
      */
     void printTree(uint32_t currentDepth = 1);
 
+    /**
+        Mark the layout of this node as dirty. The parent computes this node's scale & position so it gets marked as
+        well, going further up for as long as the parents FIT around their subNodes. Only dirty subtrees are laid out
+        again on the next layout pass.
+     */
+    void markLayoutDirty();
+
 
     /* Setters */
     void setType(const NodeType type);
@@ -222,6 +254,7 @@ public:
     const std::string& getName() const;
     const char* getCName() const;
     uint32_t getId() const;
+    NodeHandle getHandle() const;
     NodeType getType() const;
     AbstractNodePVec& getChildren();
     utils::Layout& getLayout();
@@ -231,6 +264,7 @@ public:
 
 private: // friend
     friend WindowFrame;
+    friend CustomLayoutEngine;
     AbstractNode* getParentRaw();
 
 private:
@@ -252,8 +286,20 @@ private:
     FrameStatePtr state_{nullptr};
     AbstractNode* parentRaw_{nullptr}; 
 
+    /* Incremental layout bookkeeping, managed by the frame. Position & scale are the ones the subNodes were last
+       laid out with. Subtrees without dirty subNodes are not walked at all. */
+    bool isLayoutDirty_{true};
+    bool hasDirtySubNodes_{true};
+    glm::vec3 laidOutPos_{-1};
+    glm::vec3 laidOutScale_{-1};
+
+    /* Last FIT measurement of the subNodes. Dropped whenever the layout of this node or of a subNode changes. */
+    bool isFitScaleValid_{false};
+    glm::vec2 fitScale_{0};
+
 protected:
     uint32_t id_{0};
+    NodeHandle handle_;
     std::string name_;
     NodeType nodeType_{NodeType::COMMON};
     utils::Transform transform_;
@@ -3,6 +3,7 @@
 #include "msgui/layoutEngine/utils/LayoutData.hpp"
 #include "msgui/loaders/MeshLoader.hpp"
 #include "msgui/loaders/ShaderLoader.hpp"
+#include "msgui/renderer/Uniforms.hpp"
 #include "msgui/node/AbstractNode.hpp"
 #include "msgui/node/Dropdown.hpp"
 #include "msgui/node/FloatingBox.hpp"
@@ -32,6 +33,10 @@ Box::Box(const std::string& name)
         std::bind(&Box::onLMBRelease, this, std::placeholders::_1));
     getEvents().listen<events::FocusLost, events::InputChannel>(
         std::bind(&Box::onFocusLost, this, std::placeholders::_1));
+    getEvents().listen<events::WheelScroll, events::InputChannel>(
+        std::bind(&Box::onWheelScroll, this, std::placeholders::_1));
+    getEvents().listen<events::WheelScroll, events::BubbleChannel>(
+        std::bind(&Box::onWheelScroll, this, std::placeholders::_1));
 }
 
 DropdownWPtr Box::createContextMenu()
@@ -63,13 +68,19 @@ void Box::setShaderAttributes()
 {
     transform_.computeModelMatrix();
     auto shader = getShader();
+    const renderer::Uniforms& uniforms = renderer::Uniforms::get();
+
+    shader->setMat4f(uniforms.modelMat, transform_.modelMatrix);
+    shader->setVec4f(uniforms.color, color_);
+    shader->setVec4f(uniforms.borderColor, borderColor_);
+    shader->setVec4f(uniforms.borderSize, layout_.border);
+    shader->setVec4f(uniforms.borderRadii, layout_.borderRadius);
+    shader->setVec2f(uniforms.resolution, glm::vec2{transform_.scale.x, transform_.scale.y});
+}
 
-    shader->setMat4f("uModelMat", transform_.modelMatrix);
-    shader->setVec4f("uColor", color_);
-    shader->setVec4f("uBorderColor", borderColor_);
-    shader->setVec4f("uBorderSize", layout_.border);
-    shader->setVec4f("uBorderRadii", layout_.borderRadius);
-    shader->setVec2f("uResolution", glm::vec2{transform_.scale.x, transform_.scale.y});
+bool Box::setInstanceAttributes(renderer::RectInstanceData& data)
+{
+    return fillRectInstance(data, color_, borderColor_);
 }
 
 void Box::onLMBRelease(const events::LMBRelease& ev)
@@ -89,8 +100,8 @@ void Box::onFocusLost(const events::FocusLost&)
     /* Nothing to be done if no context menu is assigned or if focus is lost
        BUT the newly clicked node is a drop item (the menu's one most likely). */
     if (!ctxMenuFloatingBox_) { return; }
-    if (getState()->clickedNodePtr.lock()->getName() == "DropdownItem"
-        || getState()->clickedNodePtr.lock()->getName() == "SubDropdown")
+    const AbstractNode* clickedNode = NodeRegistry::get().resolve(getState()->clickedNode);
+    if (clickedNode->getName() == "DropdownItem" || clickedNode->getName() == "SubDropdown")
     {
         return;
     }
@@ -110,6 +121,20 @@ void Box::onRMBRelease(const events::RMBRelease& evt)
     Utils::as<Dropdown>(ddd)->setDropdownOpen(true);
 }
 
+void Box::onWheelScroll(const events::WheelScroll& evt)
+{
+    /* Scroll with whatever bar is active, the event stops here so outer boxes don't scroll as well. */
+    SliderPtr scrollBar{nullptr};
+    if (isScrollBarActive(utils::Layout::Type::VERTICAL)) { scrollBar = vScrollBar_; }
+    // TODO: When CTRL is held pick the horizontal direction instead of the verical one
+    else if (isScrollBarActive(utils::Layout::Type::HORIZONTAL)) { scrollBar = hScrollBar_; }
+    if (!scrollBar) { return; }
+
+    events::WheelScroll barEvt{evt.value};
+    scrollBar->getEvents().notifyAllChannels(barEvt);
+    evt.stopPropagation();
+}
+
 bool Box::isScrollBarActive(const utils::Layout::Type type)
 {
     if (type == utils::Layout::Type::HORIZONTAL)
@@ -174,7 +199,7 @@ void Box::setupReloadables()
         if (layout_.allowOverflow.x && !hScrollBar_)
         {
 
-            hScrollBar_ = std::make_shared<Slider>("HSlider");
+            hScrollBar_ = Utils::make<Slider>("HSlider");
             hScrollBar_->enableViewValue(false).enableDynamicKnob(true);
             hScrollBar_->setType(AbstractNode::NodeType::SCROLL);
             hScrollBar_->getLayout().setNewScale({1.0_rel, 20_px});
@@ -190,7 +215,7 @@ void Box::setupReloadables()
 
         if (layout_.allowOverflow.y && !vScrollBar_)
         {
-            vScrollBar_ = std::make_shared<Slider>("VSlider");
+            vScrollBar_ = Utils::make<Slider>("VSlider");
             vScrollBar_->enableDynamicKnob(true);
             vScrollBar_->getLayout()
                 .setType(utils::Layout::Type::VERTICAL)
@@ -205,6 +230,8 @@ void Box::setupReloadables()
             remove(hScrollBar_->getId());
             vScrollBar_.reset();
         }
+
+        MAKE_LAYOUT_DIRTY
     };
 }
 
@@ -212,12 +239,14 @@ void Box::setupReloadables()
 Box& Box::setColor(const glm::vec4& color)
 {
     color_ = color;
+    MAKE_NODE_DAMAGED;
     return *this;
 }
 
 Box& Box::setBorderColor(const glm::vec4& color)
 {
     borderColor_ = color;
+    MAKE_NODE_DAMAGED;
     return *this;
 }
 
@@ -5,6 +5,7 @@
 #include "msgui/events/FocusLost.hpp"
 #include "msgui/events/RMBRelease.hpp"
 #include "msgui/events/LMBRelease.hpp"
+#include "msgui/events/WheelScroll.hpp"
 
 namespace msgui
 {
@@ -42,9 +43,11 @@ private:
     Box& operator=(Box&&) = delete;
 
     void setShaderAttributes() override;
+    bool setInstanceAttributes(renderer::RectInstanceData& data) override;
     void onLMBRelease(const events::LMBRelease& evt);
     void onRMBRelease(const events::RMBRelease& evt);
     void onFocusLost(const events::FocusLost& evt);
+    void onWheelScroll(const events::WheelScroll& evt);
     void setupReloadables();
 
 private:
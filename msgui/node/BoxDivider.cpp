@@ -2,6 +2,7 @@
 
 #include "msgui/loaders/MeshLoader.hpp"
 #include "msgui/loaders/ShaderLoader.hpp"
+#include "msgui/renderer/Uniforms.hpp"
 #include "msgui/node/AbstractNode.hpp"
 #include "msgui/node/Box.hpp"
 #include "msgui/node/FrameState.hpp"
@@ -31,7 +32,7 @@ void BoxDivider::createSlots(const std::vector<Layout::Scale>& initialScale)
     float totalScale{0.0};
     for (uint32_t i = 0; i < initialScale.size(); i++)
     {
-        auto ref = boxes.emplace_back(std::make_shared<Box>("Box" + std::to_string(i)));
+        auto ref = boxes.emplace_back(Utils::make<Box>("Box" + std::to_string(i)));
         ref->setColor(Utils::randomRGB());
         if (layout_.type == utils::Layout::Type::HORIZONTAL)
         {
@@ -57,12 +58,18 @@ void BoxDivider::setShaderAttributes()
 {
     transform_.computeModelMatrix();
     auto shader = getShader();
-    shader->setMat4f("uModelMat", transform_.modelMatrix);
-    shader->setVec4f("uColor", color_);
-    shader->setVec4f("uBorderColor", borderColor_);
-    shader->setVec4f("uBorderSize", layout_.border);
-    shader->setVec4f("uBorderRadii", layout_.borderRadius);
-    shader->setVec2f("uResolution", glm::vec2{transform_.scale.x, transform_.scale.y});
+    const renderer::Uniforms& uniforms = renderer::Uniforms::get();
+    shader->setMat4f(uniforms.modelMat, transform_.modelMatrix);
+    shader->setVec4f(uniforms.color, color_);
+    shader->setVec4f(uniforms.borderColor, borderColor_);
+    shader->setVec4f(uniforms.borderSize, layout_.border);
+    shader->setVec4f(uniforms.borderRadii, layout_.borderRadius);
+    shader->setVec2f(uniforms.resolution, glm::vec2{transform_.scale.x, transform_.scale.y});
+}
+
+bool BoxDivider::setInstanceAttributes(renderer::RectInstanceData& data)
+{
+    return fillRectInstance(data, color_, borderColor_);
 }
 
 void BoxDivider::appendBoxContainers(const std::vector<BoxPtr>& boxes)
@@ -90,7 +97,7 @@ void BoxDivider::appendBoxContainers(const std::vector<BoxPtr>& boxes)
                 and previous node for each separator and current box node can be the previous of the next separator.
                 We cannot parent nodes to 2 nodes.
             */
-            BoxDividerSepPtr sep = std::make_shared<BoxDividerSep>(
+            BoxDividerSepPtr sep = Utils::make<BoxDividerSep>(
                 "BoxDividerSep" + std::to_string(i),
                 *thisBoxIt,
                 *nextBoxIt);
@@ -148,12 +155,14 @@ BoxDividerSepWPtr BoxDivider::getSepatator(uint32_t sepNumber)
 BoxDivider& BoxDivider::setColor(const glm::vec4& color)
 {
     color_ = color;
+    MAKE_NODE_DAMAGED;
     return *this;
 }
 
 BoxDivider& BoxDivider::setBorderColor(const glm::vec4& color)
 {
     borderColor_ = color;
+    MAKE_NODE_DAMAGED;
     return *this;
 }
 
@@ -34,6 +34,7 @@ private:
     BoxDivider& operator=(BoxDivider&&) = delete;
 
     void setShaderAttributes() override;
+    bool setInstanceAttributes(renderer::RectInstanceData& data) override;
 
     void appendBoxContainers(const std::vector<BoxPtr>& boxes);
     void setupLayoutReloadables();
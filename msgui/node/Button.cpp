@@ -10,6 +10,7 @@
 #include "msgui/layoutEngine/utils/LayoutData.hpp"
 #include "msgui/loaders/MeshLoader.hpp"
 #include "msgui/loaders/ShaderLoader.hpp"
+#include "msgui/renderer/Uniforms.hpp"
 #include "msgui/node/FrameState.hpp"
 #include "msgui/Utils.hpp"
 #include "msgui/node/Image.hpp"
@@ -51,12 +52,18 @@ void Button::setShaderAttributes()
 {
     transform_.computeModelMatrix();
     auto shader = getShader();
-    shader->setMat4f("uModelMat", transform_.modelMatrix);
-    shader->setVec4f("uColor", isEnabled_ ? currentColor_ : disabledColor_);
-    shader->setVec4f("uBorderColor", borderColor_);
-    shader->setVec4f("uBorderSize", layout_.border);
-    shader->setVec4f("uBorderRadii", layout_.borderRadius);
-    shader->setVec2f("uResolution", glm::vec2{transform_.scale.x, transform_.scale.y});
+    const renderer::Uniforms& uniforms = renderer::Uniforms::get();
+    shader->setMat4f(uniforms.modelMat, transform_.modelMatrix);
+    shader->setVec4f(uniforms.color, isEnabled_ ? currentColor_ : disabledColor_);
+    shader->setVec4f(uniforms.borderColor, borderColor_);
+    shader->setVec4f(uniforms.borderSize, layout_.border);
+    shader->setVec4f(uniforms.borderRadii, layout_.borderRadius);
+    shader->setVec2f(uniforms.resolution, glm::vec2{transform_.scale.x, transform_.scale.y});
+}
+
+bool Button::setInstanceAttributes(renderer::RectInstanceData& data)
+{
+    return fillRectInstance(data, isEnabled_ ? currentColor_ : disabledColor_, borderColor_);
 }
 
 void Button::onMouseClick(const events::LMBClick&)
@@ -64,7 +71,7 @@ void Button::onMouseClick(const events::LMBClick&)
     currentColor_ = pressedColor_;
 
     // layout_.shrink = {2, 2};
-    MAKE_LAYOUT_DIRTY;
+    MAKE_NODE_DAMAGED;
 }
 
 void Button::onMouseRelease(const events::LMBRelease&)
@@ -72,7 +79,7 @@ void Button::onMouseRelease(const events::LMBRelease&)
     currentColor_ = baseColor_;
 
     // layout_.shrink = {0, 0};
-    MAKE_LAYOUT_DIRTY;
+    MAKE_NODE_DAMAGED;
 }
 
 void Button::onMouseReleaseNotHovered(const events::LMBReleaseNotHovered&)
@@ -85,11 +92,13 @@ void Button::onMouseReleaseNotHovered(const events::LMBReleaseNotHovered&)
 void Button::onMouseEnter(const events::MouseEnter&)
 {
     currentColor_ = hoveredColor_;
+    MAKE_NODE_DAMAGED;
 }
 
 void Button::onMouseExit(const events::MouseExit&)
 {
     currentColor_ = baseColor_;
+    MAKE_NODE_DAMAGED;
 }
 
 Button& Button::setColor(const glm::vec4& color)
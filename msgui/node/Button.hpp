@@ -40,6 +40,7 @@ protected:
     Button& operator=(Button&&) = delete;
 
     void setShaderAttributes() override;
+    bool setInstanceAttributes(renderer::RectInstanceData& data) override;
     void onMouseClick(const events::LMBClick& evt);
     void onMouseRelease(const events::LMBRelease& evt);
     void onMouseReleaseNotHovered(const events::LMBReleaseNotHovered& evt);
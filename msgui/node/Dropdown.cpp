@@ -9,6 +9,7 @@
 #include "msgui/events/NodeEventManager.hpp"
 #include "msgui/loaders/MeshLoader.hpp"
 #include "msgui/loaders/ShaderLoader.hpp"
+#include "msgui/renderer/Uniforms.hpp"
 #include "msgui/node/AbstractNode.hpp"
 #include "msgui/node/Box.hpp"
 #include "msgui/node/FrameState.hpp"
@@ -52,13 +53,19 @@ void Dropdown::setShaderAttributes()
 {
     transform_.computeModelMatrix();
     auto shader = getShader();
+    const renderer::Uniforms& uniforms = renderer::Uniforms::get();
+
+    shader->setMat4f(uniforms.modelMat, transform_.modelMatrix);
+    shader->setVec4f(uniforms.color, currentColor_);
+    shader->setVec4f(uniforms.borderColor, borderColor_);
+    shader->setVec4f(uniforms.borderSize, layout_.border);
+    shader->setVec4f(uniforms.borderRadii, layout_.borderRadius);
+    shader->setVec2f(uniforms.resolution, glm::vec2{transform_.scale.x, transform_.scale.y});
+}
 
-    shader->setMat4f("uModelMat", transform_.modelMatrix);
-    shader->setVec4f("uColor", currentColor_);
-    shader->setVec4f("uBorderColor", borderColor_);
-    shader->setVec4f("uBorderSize", layout_.border);
-    shader->setVec4f("uBorderRadii", layout_.borderRadius);
-    shader->setVec2f("uResolution", glm::vec2{transform_.scale.x, transform_.scale.y});
+bool Dropdown::setInstanceAttributes(renderer::RectInstanceData& data)
+{
+    return fillRectInstance(data, currentColor_, borderColor_);
 }
 
 void Dropdown::onMouseClick(const events::LMBClick&)
@@ -99,7 +106,8 @@ void Dropdown::onFocusLost(const events::FocusLost&)
     if (!dropdownOpen_) { return; }
 
     const FrameStatePtr& state = getState();
-    const AbstractNodePtr& parentBoxCont = state->clickedNodePtr.lock()->getParent().lock();
+    AbstractNode* clickedNode = NodeRegistry::get().resolve(state->clickedNode);
+    const AbstractNodePtr& parentBoxCont = clickedNode->getParent().lock();
     const AbstractNodePtr& grandParentDd = parentBoxCont ? parentBoxCont->getParent().lock() : nullptr;
     if (!grandParentDd || grandParentDd->getType() != AbstractNode::NodeType::DROPDOWN ||
         Utils::as<Dropdown>(grandParentDd)->getDropdownId() != dropdownId_)
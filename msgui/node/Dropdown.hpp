@@ -102,6 +102,7 @@ private:
     Dropdown& operator=(Dropdown&&) = delete;
 
     void setShaderAttributes() override;
+    bool setInstanceAttributes(renderer::RectInstanceData& data) override;
     void onMouseRelease(const events::LMBRelease&);
     void onMouseReleaseNotHovered(const events::LMBReleaseNotHovered&);
     void onMouseClick(const events::LMBClick&);
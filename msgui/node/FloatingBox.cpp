@@ -2,6 +2,7 @@
 
 #include "msgui/loaders/MeshLoader.hpp"
 #include "msgui/loaders/ShaderLoader.hpp"
+#include "msgui/renderer/Uniforms.hpp"
 #include "msgui/node/FrameState.hpp"
 
 namespace msgui
@@ -29,12 +30,18 @@ void FloatingBox::setShaderAttributes()
 {
     transform_.computeModelMatrix();
     auto shader = getShader();
-    shader->setMat4f("uModelMat", transform_.modelMatrix);
-    shader->setVec4f("uColor", color_);
-    shader->setVec4f("uBorderColor", borderColor_);
-    shader->setVec4f("uBorderSize", layout_.border);
-    shader->setVec4f("uBorderRadii", layout_.borderRadius);
-    shader->setVec2f("uResolution", glm::vec2{transform_.scale.x, transform_.scale.y});
+    const renderer::Uniforms& uniforms = renderer::Uniforms::get();
+    shader->setMat4f(uniforms.modelMat, transform_.modelMatrix);
+    shader->setVec4f(uniforms.color, color_);
+    shader->setVec4f(uniforms.borderColor, borderColor_);
+    shader->setVec4f(uniforms.borderSize, layout_.border);
+    shader->setVec4f(uniforms.borderRadii, layout_.borderRadius);
+    shader->setVec2f(uniforms.resolution, glm::vec2{transform_.scale.x, transform_.scale.y});
+}
+
+bool FloatingBox::setInstanceAttributes(renderer::RectInstanceData& data)
+{
+    return fillRectInstance(data, color_, borderColor_);
 }
 
 void FloatingBox::onMouseRelease(const events::LMBRelease& evt)
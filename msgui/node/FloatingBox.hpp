@@ -26,6 +26,7 @@ private:
     FloatingBox& operator=(FloatingBox&&) = delete;
 
     void setShaderAttributes() override;
+    bool setInstanceAttributes(renderer::RectInstanceData& data) override;
 
     void onMouseRelease(const events::LMBRelease& evt);
 private:
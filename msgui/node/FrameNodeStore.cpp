@@ -0,0 +1,63 @@
+#include "FrameNodeStore.hpp"
+
+namespace msgui
+{
+void FrameNodeStore::insert(const AbstractNodePtr& node, const uint32_t level)
+{
+    const uint32_t slot = node->getTransform().slot;
+    if (contains(slot)) { return; }
+
+    if (slot >= positions_.size()) { positions_.resize(slot + 1); }
+
+    const int32_t z = node->getTransform().pos.z;
+    Bucket& bucket = buckets_[z];
+    positions_[slot] = Position{.z = z, .idx = (uint32_t)bucket.nodes.size(), .level = level};
+    bucket.nodes.push_back(node);
+    bucket.slots.push_back(slot);
+    size_++;
+}
+
+AbstractNodePtr FrameNodeStore::remove(const uint32_t slot)
+{
+    if (!contains(slot)) { return nullptr; }
+
+    Position& pos = positions_[slot];
+    const auto bucketIt = buckets_.find(pos.z);
+    Bucket& bucket = bucketIt->second;
+
+    /* Last node takes the place of the removed one. */
+    AbstractNodePtr removed = std::move(bucket.nodes[pos.idx]);
+    const uint32_t lastIdx = bucket.nodes.size() - 1;
+    if (pos.idx != lastIdx)
+    {
+        bucket.nodes[pos.idx] = std::move(bucket.nodes[lastIdx]);
+        bucket.slots[pos.idx] = bucket.slots[lastIdx];
+        positions_[bucket.slots[pos.idx]].idx = pos.idx;
+    }
+    bucket.nodes.pop_back();
+    bucket.slots.pop_back();
+    pos.idx = NOT_STORED;
+    size_--;
+
+    if (bucket.nodes.empty()) { buckets_.erase(bucketIt); }
+
+    return removed;
+}
+
+bool FrameNodeStore::contains(const uint32_t slot) const
+{
+    return slot < positions_.size() && positions_[slot].idx != NOT_STORED;
+}
+
+const AbstractNodePtr& FrameNodeStore::getNode(const uint32_t slot) const
+{
+    const Position& pos = positions_[slot];
+    return buckets_.find(pos.z)->second.nodes[pos.idx];
+}
+
+uint32_t FrameNodeStore::getLevel(const uint32_t slot) const { return positions_[slot].level; }
+
+const FrameNodeStore::Buckets& FrameNodeStore::getBuckets() const { return buckets_; }
+
+uint32_t FrameNodeStore::getSize() const { return size_; }
+} // namespace msgui
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <vector>
+
+#include "msgui/node/AbstractNode.hpp"
+
+namespace msgui
+{
+/* Flattened nodes of a frame, grouped in buckets by depth (z) and ordered from high to low depth. Nodes get inserted
+   and removed one by one as subtrees are attached to or detached from the frame, so structural changes cost time
+   proportional to the nodes involved rather than to the whole tree. Order inside of a bucket is not kept. */
+class FrameNodeStore
+{
+public:
+    struct Bucket
+    {
+        AbstractNodePVec nodes;
+        std::vector<uint32_t> slots;
+    };
+    using Buckets = std::map<int32_t, Bucket, std::greater<int32_t>>;
+
+    /**
+        Insert a node into the bucket of its current depth. Depth shall not change while the node is stored.
+
+        @param node Node to be inserted
+        @param level Tree level of the node, root being zero
+    */
+    void insert(const AbstractNodePtr& node, const uint32_t level);
+
+    /**
+        Remove a node by its transform slot.
+
+        @param slot Transform slot of the node
+
+        @return Removed node or nullptr if it wasn't stored
+    */
+    AbstractNodePtr remove(const uint32_t slot);
+
+    /**
+        Check if the node owning the transform slot is stored.
+
+        @param slot Transform slot of the node
+
+        @return True if stored, false otherwise
+    */
+    bool contains(const uint32_t slot) const;
+
+    /**
+        Get a stored node by its transform slot.
+
+        @param slot Transform slot of a stored node
+
+        @return Stored node
+    */
+    const AbstractNodePtr& getNode(const uint32_t slot) const;
+
+    /**
+        Get the tree level a stored node was inserted with.
+
+        @param slot Transform slot of a stored node
+
+        @return Tree level
+    */
+    uint32_t getLevel(const uint32_t slot) const;
+
+    /**
+        Get the buckets of nodes, ordered from high to low depth.
+
+        @return Buckets
+    */
+    const Buckets& getBuckets() const;
+
+    /**
+        Get the number of stored nodes.
+
+        @return Number of nodes
+    */
+    uint32_t getSize() const;
+
+    /**
+        Call a function for each node, from high to low depth.
+
+        @param fn Function to be called with each node
+    */
+    template<typename Fn>
+    void forEachHighToLow(Fn&& fn) const
+    {
+        for (const auto& [z, bucket] : buckets_)
+        {
+            for (const auto& node : bucket.nodes) { fn(node); }
+        }
+    }
+
+    /**
+        Call a function for each node, from low to high depth. This is draw order, not tree order: scroll nodes get a
+        depth that decreases as their parent's increases, so they can come before their parent.
+
+        @param fn Function to be called with each node
+    */
+    template<typename Fn>
+    void forEachLowToHigh(Fn&& fn) const
+    {
+        for (auto it = buckets_.rbegin(); it != buckets_.rend(); ++it)
+        {
+            for (const auto& node : it->second.nodes) { fn(node); }
+        }
+    }
+
+private:
+    static constexpr uint32_t NOT_STORED = UINT32_MAX;
+
+    struct Position
+    {
+        int32_t z{0};
+        uint32_t idx{NOT_STORED};
+        uint32_t level{0};
+    };
+
+private:
+    Buckets buckets_;
+    std::vector<Position> positions_;
+    uint32_t size_{0};
+};
+} // namespace msgui
@@ -1,11 +1,16 @@
 #pragma once
 
-#include <memory>
+#include <cstdint>
 #include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
 
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 
+#include "msgui/node/NodeRegistry.hpp"
+
 namespace msgui
 {
 // TODO: Implement bitwise & and | so we dont rely on declaring it as uint8_t in FrameState
@@ -18,9 +23,10 @@ enum ELayoutPass : uint8_t
 };
 
 #define MAKE_TEXT_LAYOUT_DIRTY if (getState()) { getState()->layoutPassActions |= ELayoutPass::EVERYTHING_TEXT;  };
-#define MAKE_LAYOUT_DIRTY      if (getState()) { getState()->layoutPassActions |= ELayoutPass::RECALCULATE_NODE_TRANSFORM; };
+#define MAKE_LAYOUT_DIRTY      markLayoutDirty();
 #define REQUEST_STORE_RECREATE if (getState()) { getState()->layoutPassActions |= ELayoutPass::RESOLVE_NODE_RELATIONS; };
-#define REQUEST_NEW_FRAME      if (getState()) { getState()->requestNewFrameFunc(); };
+#define MAKE_NODE_DAMAGED      if (getState()) { getState()->damageArea.add(getId(), transform_.vPos, transform_.vScale); };
+#define REQUEST_NEW_FRAME      if (getState()) { MAKE_NODE_DAMAGED getState()->requestNewFrameFunc(); };
 #define MAKE_LAYOUT_DIRTY_AND_REQUEST_NEW_FRAME\
     MAKE_LAYOUT_DIRTY \
     REQUEST_STORE_RECREATE\
@@ -35,6 +41,68 @@ static constexpr int32_t NO_ID = 0;
 static constexpr int32_t NO_VALUE = 0;
 static const AbstractNodePtr NO_PTR = nullptr;
 
+/* Screen area (top left origin, in pixels) that needs to be redrawn on the next frame, plus the nodes whose
+   visual properties changed in order to cause it. */
+struct DamageArea
+{
+    /**
+        Extend the damaged area so that it also covers the given node's rectangle.
+
+        @param nodeId Id of the node that got damaged
+        @param pos Top left corner of the rectangle
+        @param size Size of the rectangle
+    */
+    void add(const uint32_t nodeId, const glm::ivec2& pos, const glm::ivec2& size)
+    {
+        nodeIds.push_back(nodeId);
+        if (size.x <= 0 || size.y <= 0) { return; }
+        min = glm::min(min, pos);
+        max = glm::max(max, pos + size);
+    }
+
+    /**
+        Mark the whole frame as damaged.
+    */
+    void addFull() { isFull = true; }
+
+    /**
+        Forget about everything damaged so far. Called after the frame got redrawn.
+    */
+    void reset()
+    {
+        min = glm::ivec2{std::numeric_limits<int32_t>::max()};
+        max = glm::ivec2{std::numeric_limits<int32_t>::min()};
+        isFull = false;
+        nodeIds.clear();
+    }
+
+    /**
+        Check if anything needs to be redrawn.
+
+        @return True if nothing is damaged
+    */
+    bool isEmpty() const { return !isFull && (min.x >= max.x || min.y >= max.y); }
+
+    /**
+        Check if the given rectangle overlaps the damaged area.
+
+        @param pos Top left corner of the rectangle
+        @param size Size of the rectangle
+
+        @return True if the rectangle needs to be redrawn
+    */
+    bool intersects(const glm::ivec2& pos, const glm::ivec2& size) const
+    {
+        if (isFull) { return true; }
+        return pos.x < max.x && pos.x + size.x > min.x && pos.y < max.y && pos.y + size.y > min.y;
+    }
+
+    glm::ivec2 min{std::numeric_limits<int32_t>::max()};
+    glm::ivec2 max{std::numeric_limits<int32_t>::min()};
+    bool isFull{true};
+    std::vector<uint32_t> nodeIds;
+};
+
 struct FrameState
 {
     int32_t mouseButtonState[GLFW_MOUSE_BUTTON_LAST]{NO_VALUE};
@@ -44,14 +112,16 @@ struct FrameState
     int32_t lastMouseX                              {NO_VALUE};
     int32_t lastMouseY                              {NO_VALUE};
     glm::ivec2 frameSize                            {NO_VALUE, NO_VALUE};
-    AbstractNodeWPtr clickedNodePtr                 {NO_PTR};
-    AbstractNodeWPtr prevClickedNodePtr             {NO_PTR};
-    AbstractNodeWPtr hoveredNodePtr                 {NO_PTR};
-    AbstractNodeWPtr nearScrollNodePtr              {NO_PTR};
+    NodeHandle clickedNode                          {NO_HANDLE};
+    NodeHandle prevClickedNode                      {NO_HANDLE};
+    NodeHandle hoveredNode                          {NO_HANDLE};
     std::function<void()> requestNewFrameFunc       {nullptr};
     uint8_t layoutPassActions                       {ELayoutPass::EVERYTHING_NODE};
     int32_t currentCursorId                         {GLFW_ARROW_CURSOR};
     int32_t prevCursorId                            {GLFW_ARROW_CURSOR};
+    DamageArea damageArea                           {};
+    std::vector<AbstractNodePtr> attachedNodes      {};
+    std::vector<uint32_t> detachedSlots             {};
 };
 
 using FrameStatePtr = std::shared_ptr<FrameState>;
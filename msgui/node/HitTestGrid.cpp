@@ -0,0 +1,97 @@
+#include "HitTestGrid.hpp"
+
+#include <algorithm>
+
+#include "msgui/layoutEngine/utils/TransformStore.hpp"
+
+namespace msgui
+{
+void HitTestGrid::rebuild(const FrameNodeStore& nodes, const glm::ivec2& frameSize)
+{
+    /* Edges are inclusive, a point right on the frame's far edge still needs a cell. */
+    cols_ = std::max(frameSize.x, 0) / CELL_SIZE + 1;
+    rows_ = std::max(frameSize.y, 0) / CELL_SIZE + 1;
+    cellStarts_.assign(cols_ * rows_ + 1, 0);
+
+    /* Two passes over the nodes. First one counts the slots of each cell, second one places them. Buckets are
+       visited from high to low depth so each cell ends up ordered the same way. */
+    utils::TransformStore& trStore = utils::TransformStore::get();
+    const auto forEachCoveredCell = [this, &nodes, &trStore](auto&& fn)
+    {
+        for (const auto& [z, bucket] : nodes.getBuckets())
+        {
+            for (const uint32_t slot : bucket.slots)
+            {
+                const glm::ivec2& vPos = trStore.vPos(slot);
+                const glm::ivec2& vScale = trStore.vScale(slot);
+                if (vScale.x < 0 || vScale.y < 0) { continue; }
+
+                const glm::ivec2 colRange = cellRange(vPos.x, vPos.x + vScale.x, cols_);
+                const glm::ivec2 rowRange = cellRange(vPos.y, vPos.y + vScale.y, rows_);
+                for (int32_t row = rowRange.x; row <= rowRange.y; row++)
+                {
+                    for (int32_t col = colRange.x; col <= colRange.y; col++)
+                    {
+                        fn(row * cols_ + col, slot);
+                    }
+                }
+            }
+        }
+    };
+
+    forEachCoveredCell([this](const int32_t cell, const uint32_t) { cellStarts_[cell + 1]++; });
+    for (uint32_t i = 1; i < cellStarts_.size(); i++)
+    {
+        cellStarts_[i] += cellStarts_[i - 1];
+    }
+
+    cellSlots_.resize(cellStarts_.back());
+    std::vector<uint32_t> fillPos(cellStarts_.begin(), cellStarts_.end() - 1);
+    forEachCoveredCell([this, &fillPos](const int32_t cell, const uint32_t slot)
+    {
+        cellSlots_[fillPos[cell]++] = slot;
+    });
+}
+
+AbstractNode* HitTestGrid::findNodeAt(const FrameNodeStore& nodes, const int32_t x, const int32_t y) const
+{
+    if (cols_ == 0 || rows_ == 0) { return nullptr; }
+
+    /* Rects reaching outside the frame were clamped into the edge cells, so points outside get clamped as well. */
+    const int32_t col = std::clamp(x / CELL_SIZE, 0, cols_ - 1);
+    const int32_t row = std::clamp(y / CELL_SIZE, 0, rows_ - 1);
+    const int32_t cell = row * cols_ + col;
+
+    utils::TransformStore& trStore = utils::TransformStore::get();
+    for (uint32_t i = cellStarts_[cell]; i < cellStarts_[cell + 1]; i++)
+    {
+        const uint32_t slot = cellSlots_[i];
+        const glm::ivec2& nodePos = trStore.vPos(slot);
+        const glm::ivec2& nodeScale = trStore.vScale(slot);
+        if ((x >= nodePos.x && x <= nodePos.x + nodeScale.x) &&
+            (y >= nodePos.y && y <= nodePos.y + nodeScale.y))
+        {
+            /* Node might have left the frame since the grid got built. */
+            if (!nodes.contains(slot)) { continue; }
+
+            /* Skip nodes marked as transparent. Events will be bubbled down to the next valid node. */
+            const AbstractNodePtr& node = nodes.getNode(slot);
+            if (node->isEventTransparent()) { continue; }
+
+            return node.get();
+        }
+    }
+    return nullptr;
+}
+
+glm::ivec2 HitTestGrid::cellRange(const int32_t start, const int32_t end, const int32_t cellCount) const
+{
+    /* Floor division so negative coordinates land in the first cell after clamping. */
+    const auto toCell = [cellCount](const int32_t v)
+    {
+        const int32_t cell = v >= 0 ? v / CELL_SIZE : -1;
+        return std::clamp(cell, 0, cellCount - 1);
+    };
+    return {toCell(start), toCell(end)};
+}
+} // namespace msgui
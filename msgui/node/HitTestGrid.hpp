@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "msgui/node/AbstractNode.hpp"
+#include "msgui/node/FrameNodeStore.hpp"
+
+namespace msgui
+{
+/* Uniform grid over the frame used to find the topmost node under a point. Each cell lists the transform slots of the
+   nodes whose viewable area overlaps it, from high to low depth, so a lookup only tests the few nodes sharing the
+   cell of the point instead of every node of the frame. */
+class HitTestGrid
+{
+public:
+    static constexpr int32_t CELL_SIZE{64};
+
+    /**
+        Rebuild the grid from the current viewable areas of the stored nodes.
+
+        @param nodes Store of the frame nodes
+        @param frameSize Size of the frame in pixels
+    */
+    void rebuild(const FrameNodeStore& nodes, const glm::ivec2& frameSize);
+
+    /**
+        Find the topmost node whose viewable area contains the point and is not event transparent.
+
+        @param nodes Store of the frame nodes the grid was built from
+        @param x Point X coordinate
+        @param y Point Y coordinate
+
+        @return Found node or nullptr if there's none
+    */
+    AbstractNode* findNodeAt(const FrameNodeStore& nodes, const int32_t x, const int32_t y) const;
+
+private:
+    glm::ivec2 cellRange(const int32_t start, const int32_t end, const int32_t cellCount) const;
+
+private:
+    int32_t cols_{0};
+    int32_t rows_{0};
+
+    /* Cells are kept flat. Slots of cell i are cellSlots_[cellStarts_[i]..cellStarts_[i + 1]). */
+    std::vector<uint32_t> cellStarts_;
+    std::vector<uint32_t> cellSlots_;
+};
+} // namespace msgui
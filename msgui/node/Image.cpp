@@ -4,6 +4,7 @@
 
 #include "msgui/loaders/MeshLoader.hpp"
 #include "msgui/loaders/ShaderLoader.hpp"
+#include "msgui/renderer/Uniforms.hpp"
 #include "msgui/loaders/TextureLoader.hpp"
 #include "msgui/Utils.hpp"
 #include "msgui/node/FrameState.hpp"
@@ -27,16 +28,17 @@ void Image::setShaderAttributes()
 {
     transform_.computeModelMatrix();
     auto shader = getShader();
+    const renderer::Uniforms& uniforms = renderer::Uniforms::get();
     int32_t texId = btnTex_ ? btnTex_->getId() : 0;
 
-    shader->setMat4f("uModelMat", transform_.modelMatrix);
-    shader->setVec4f("uColor", color_);
-    shader->setVec4f("uBorderColor", borderColor_);
-    shader->setVec4f("uBorderSize", layout_.border);
-    shader->setVec4f("uBorderRadii", layout_.borderRadius);
-    shader->setVec2f("uResolution", glm::vec2{transform_.scale.x, transform_.scale.y});
-    shader->setInt("uUseTexture", texId);
-    shader->setTexture2D("uTexture", GL_TEXTURE0, texId);
+    shader->setMat4f(uniforms.modelMat, transform_.modelMatrix);
+    shader->setVec4f(uniforms.color, color_);
+    shader->setVec4f(uniforms.borderColor, borderColor_);
+    shader->setVec4f(uniforms.borderSize, layout_.border);
+    shader->setVec4f(uniforms.borderRadii, layout_.borderRadius);
+    shader->setVec2f(uniforms.resolution, glm::vec2{transform_.scale.x, transform_.scale.y});
+    shader->setInt(uniforms.useTexture, texId);
+    shader->setTexture2D(uniforms.texture, GL_TEXTURE0, texId);
 }
 
 Image& Image::setTint(const glm::vec4& color)
@@ -0,0 +1,55 @@
+#include "NodePool.hpp"
+
+#include <new>
+
+namespace msgui
+{
+NodePool& NodePool::get()
+{
+    /* Never destroyed on purpose. Blocks may still be handed back by nodes destroyed after a function local static
+       would have been. */
+    static NodePool* instance = new NodePool;
+    return *instance;
+}
+
+void* NodePool::allocate(const std::size_t bytes)
+{
+    if (bytes == 0 || bytes > MAX_BLOCK_SIZE)
+    {
+        return ::operator new(bytes, std::align_val_t{BLOCK_ALIGN});
+    }
+
+    const std::size_t cls = sizeClass(bytes);
+    if (FreeBlock* block = freeLists_[cls])
+    {
+        freeLists_[cls] = block->next;
+        return block;
+    }
+
+    /* Carve a new block out of the current chunk. What's left of a chunk too small for the block is simply lost. */
+    const std::size_t blockSize = (cls + 1) * BLOCK_ALIGN;
+    if (chunkCursor_ == nullptr || (std::size_t)(chunkEnd_ - chunkCursor_) < blockSize)
+    {
+        chunkCursor_ = static_cast<std::byte*>(::operator new(CHUNK_SIZE, std::align_val_t{BLOCK_ALIGN}));
+        chunkEnd_ = chunkCursor_ + CHUNK_SIZE;
+    }
+
+    void* block = chunkCursor_;
+    chunkCursor_ += blockSize;
+    return block;
+}
+
+void NodePool::deallocate(void* ptr, const std::size_t bytes)
+{
+    if (!ptr) { return; }
+
+    if (bytes == 0 || bytes > MAX_BLOCK_SIZE)
+    {
+        ::operator delete(ptr, std::align_val_t{BLOCK_ALIGN});
+        return;
+    }
+
+    const std::size_t cls = sizeClass(bytes);
+    freeLists_[cls] = new (ptr) FreeBlock{freeLists_[cls]};
+}
+} // namespace msgui
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace msgui
+{
+/* Free list allocator backing node allocations. Requests are rounded up to a size class and served from big chunks
+   that are never given back to the system, so the constant create/destroy churn of nodes (recycle lists, tree views)
+   recycles the same memory instead of going through malloc each time. Oversized requests fall back to the global
+   allocator. Nodes are only created and destroyed on the UI thread, so there's no locking. */
+class NodePool
+{
+public:
+    static constexpr std::size_t BLOCK_ALIGN{64};
+    static constexpr std::size_t SIZE_CLASSES{64};
+    static constexpr std::size_t MAX_BLOCK_SIZE{BLOCK_ALIGN * SIZE_CLASSES};
+    static constexpr std::size_t CHUNK_SIZE{256 * 1024};
+
+    static NodePool& get();
+
+    /**
+        Allocate a block of memory aligned to BLOCK_ALIGN.
+
+        @param bytes Size of the block
+
+        @return Address of the block
+    */
+    void* allocate(const std::size_t bytes);
+
+    /**
+        Give back a block allocated with the same size.
+
+        @param ptr Address of the block
+        @param bytes Size the block was allocated with
+    */
+    void deallocate(void* ptr, const std::size_t bytes);
+
+private:
+    /* Cannot be copied or moved */
+    NodePool() = default;
+    NodePool(const NodePool&) = delete;
+    NodePool(NodePool&&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+    NodePool& operator=(NodePool&&) = delete;
+
+    struct FreeBlock
+    {
+        FreeBlock* next{nullptr};
+    };
+
+    inline std::size_t sizeClass(const std::size_t bytes) const { return (bytes - 1) / BLOCK_ALIGN; }
+
+private:
+    std::array<FreeBlock*, SIZE_CLASSES> freeLists_{};
+    std::byte* chunkCursor_{nullptr};
+    std::byte* chunkEnd_{nullptr};
+};
+
+/* Standard allocator adapter over the NodePool, meant for std::allocate_shared so the node and its control block
+   come from the pool in one block. */
+template<typename T>
+struct NodePoolAllocator
+{
+    using value_type = T;
+
+    NodePoolAllocator() = default;
+
+    template<typename U>
+    NodePoolAllocator(const NodePoolAllocator<U>&) {}
+
+    T* allocate(const std::size_t n)
+    {
+        static_assert(alignof(T) <= NodePool::BLOCK_ALIGN, "Type is over aligned for the node pool");
+        return static_cast<T*>(NodePool::get().allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, const std::size_t n) { NodePool::get().deallocate(ptr, n * sizeof(T)); }
+
+    template<typename U>
+    bool operator==(const NodePoolAllocator<U>&) const { return true; }
+};
+} // namespace msgui
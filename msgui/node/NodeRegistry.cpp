@@ -0,0 +1,49 @@
+#include "NodeRegistry.hpp"
+
+#include <cstdlib>
+
+namespace msgui
+{
+NodeRegistry& NodeRegistry::get()
+{
+    /* Never destroyed on purpose, same as the TransformStore. Nodes can outlive a function local static. */
+    static NodeRegistry* instance = new NodeRegistry;
+    return *instance;
+}
+
+NodeHandle NodeRegistry::acquire(AbstractNode* node)
+{
+    uint32_t index{0};
+    if (!freeIndices_.empty())
+    {
+        index = freeIndices_.back();
+        freeIndices_.pop_back();
+    }
+    else
+    {
+        index = entryCount_++;
+        const uint32_t chunkIdx = index >> CHUNK_SHIFT;
+        if (chunkIdx >= MAX_CHUNKS)
+        {
+            log_.errorLn("Out of node handles (%u)", index);
+            exit(1);
+        }
+
+        if (!chunks_[chunkIdx]) { chunks_[chunkIdx] = std::make_unique<Chunk>(); }
+    }
+
+    Entry& e = entry(index);
+    e.node = node;
+    return NodeHandle{.index = index, .generation = e.generation};
+}
+
+void NodeRegistry::release(const NodeHandle handle)
+{
+    Entry& e = entry(handle.index);
+    e.node = nullptr;
+
+    /* Zero is reserved for empty handles. */
+    if (++e.generation == 0) { e.generation = 1; }
+    freeIndices_.push_back(handle.index);
+}
+} // namespace msgui
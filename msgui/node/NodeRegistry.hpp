@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "msgui/Logger.hpp"
+
+namespace msgui
+{
+class AbstractNode;
+
+/* Weak reference to a node that doesn't own it. Resolving it is a table lookup plus a generation compare, no atomic
+   refcounting involved. A default constructed handle never resolves. */
+struct NodeHandle
+{
+    uint32_t index{0};
+    uint32_t generation{0};
+
+    bool operator==(const NodeHandle&) const = default;
+};
+
+static constexpr NodeHandle NO_HANDLE{};
+
+/* Table of all live nodes, indexed by handle. Each node registers itself on construction and unregisters on
+   destruction, bumping the generation of its entry so old handles stop resolving once the entry gets reused. Like the
+   NodePool, it's only touched from the UI thread. Storage grows in fixed chunks so entries never move. */
+class NodeRegistry
+{
+public:
+    static constexpr uint32_t CHUNK_SHIFT{12};
+    static constexpr uint32_t CHUNK_SIZE{1 << CHUNK_SHIFT};
+    static constexpr uint32_t CHUNK_MASK{CHUNK_SIZE - 1};
+    static constexpr uint32_t MAX_CHUNKS{1024};
+
+    static NodeRegistry& get();
+
+    /**
+        Register a node. Released entries get reused first.
+
+        @param node Node to register
+
+        @return Handle of the node
+    */
+    NodeHandle acquire(AbstractNode* node);
+
+    /**
+        Unregister a node. Handles to it won't resolve anymore.
+
+        @param handle Handle of the node
+    */
+    void release(const NodeHandle handle);
+
+    /**
+        Get the node a handle refers to.
+
+        @param handle Handle to resolve
+
+        @return Node or nullptr if the node is gone or the handle is empty
+    */
+    inline AbstractNode* resolve(const NodeHandle handle) const
+    {
+        if (handle.generation == 0) { return nullptr; }
+
+        const Entry& e = entry(handle.index);
+        return e.generation == handle.generation ? e.node : nullptr;
+    }
+
+private:
+    /* Cannot be copied or moved */
+    NodeRegistry() = default;
+    NodeRegistry(const NodeRegistry&) = delete;
+    NodeRegistry(NodeRegistry&&) = delete;
+    NodeRegistry& operator=(const NodeRegistry&) = delete;
+    NodeRegistry& operator=(NodeRegistry&&) = delete;
+
+    struct Entry
+    {
+        AbstractNode* node{nullptr};
+        uint32_t generation{1};
+    };
+
+    using Chunk = std::array<Entry, CHUNK_SIZE>;
+
+    inline Entry& entry(const uint32_t index) { return (*chunks_[index >> CHUNK_SHIFT])[index & CHUNK_MASK]; }
+    inline const Entry& entry(const uint32_t index) const
+    {
+        return (*chunks_[index >> CHUNK_SHIFT])[index & CHUNK_MASK];
+    }
+
+private:
+    Logger log_{"NodeRegistry"};
+    std::array<std::unique_ptr<Chunk>, MAX_CHUNKS> chunks_;
+    std::vector<uint32_t> freeIndices_;
+    uint32_t entryCount_{0};
+};
+} // namespace msgui
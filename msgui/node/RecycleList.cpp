@@ -1,11 +1,14 @@
 #include "RecycleList.hpp"
 
+#include <algorithm>
+
 #include "msgui/loaders//MeshLoader.hpp"
 #include "msgui/loaders//ShaderLoader.hpp"
 #include "msgui/node/AbstractNode.hpp"
 #include "msgui/node/Button.hpp"
 #include "msgui/node/FrameState.hpp"
 #include "msgui/events/LMBItemRelease.hpp"
+#include "msgui/renderer/Uniforms.hpp"
 
 namespace msgui
 {
@@ -25,6 +28,8 @@ RecycleList::RecycleList(const std::string& name) : Box(name)
 
 void RecycleList::addItem(const node::utils::ListItem& item)
 {
+    if (warnIfProvided("addItem")) { return; }
+
     listItems_.emplace_back(item);
     internals_.isDirty = true;
     MAKE_LAYOUT_DIRTY;
@@ -37,8 +42,25 @@ void RecycleList::addItem(const node::utils::ListItem& item)
     }
 }
 
+void RecycleList::addItems(const std::vector<node::utils::ListItem>& items)
+{
+    if (warnIfProvided("addItems") || items.empty()) { return; }
+
+    listItems_.insert(listItems_.end(), items.begin(), items.end());
+    internals_.isDirty = true;
+    MAKE_LAYOUT_DIRTY;
+
+    if (internals_.visibleNodes == 0)
+    {
+        internals_.visibleNodes = 1;
+        onLayoutDirtyPost();
+    }
+}
+
 void RecycleList::removeItemIdx(const int32_t idx)
 {
+    if (warnIfProvided("removeItemIdx")) { return; }
+
     if (idx < 0 || idx > (int32_t)listItems_.size() - 1) { return; }
     listItems_.erase(listItems_.begin() + idx);
 
@@ -48,6 +70,8 @@ void RecycleList::removeItemIdx(const int32_t idx)
 
 void RecycleList::removeItemsBy(const std::function<bool(const node::utils::ListItem&)> pred)
 {
+    if (warnIfProvided("removeItemsBy")) { return; }
+
     if (std::erase_if(listItems_, pred))
     {
         internals_.isDirty = true;
@@ -55,49 +79,141 @@ void RecycleList::removeItemsBy(const std::function<bool(const node::utils::List
     }
 }
 
+void RecycleList::setItemProvider(const int32_t itemCount, const node::utils::ListItemFetchFunc& fetch)
+{
+    setBatchItemProvider(itemCount,
+        [fetch](const int32_t firstIdx, std::span<node::utils::ListItem> items)
+        {
+            for (int32_t i = 0; i < (int32_t)items.size(); i++)
+            {
+                fetch(firstIdx + i, items[i]);
+            }
+        });
+}
+
+void RecycleList::setBatchItemProvider(const int32_t itemCount, const node::utils::ListItemBatchFetchFunc& fetchBatch)
+{
+    itemProvider_ = fetchBatch;
+    listItems_.clear();
+    listItems_.shrink_to_fit();
+    setItemCount(itemCount);
+
+    if (internals_.visibleNodes == 0)
+    {
+        internals_.visibleNodes = 1;
+        onLayoutDirtyPost();
+    }
+}
+
+void RecycleList::setItemCount(const int32_t itemCount)
+{
+    providedItemCount_ = std::max(itemCount, 0);
+    internals_.isDirty = true;
+    MAKE_LAYOUT_DIRTY_AND_REQUEST_NEW_FRAME;
+}
+
+void RecycleList::invalidateItems(const int32_t firstIdx, const int32_t count)
+{
+    /* Nothing to refetch if none of the changed items is on screen. */
+    const int32_t visibleEnd = internals_.topOfListIdx + attachedRows_;
+    if (firstIdx >= visibleEnd || firstIdx + count <= internals_.topOfListIdx) { return; }
+
+    internals_.isDirty = true;
+    MAKE_LAYOUT_DIRTY_AND_REQUEST_NEW_FRAME;
+}
+
 void RecycleList::setShaderAttributes()
 {
     transform_.computeModelMatrix();
     auto shader = getShader();
-    shader->setMat4f("uModelMat", transform_.modelMatrix);
-    shader->setVec4f("uColor", color_);
-    shader->setVec4f("uBorderColor", borderColor_);
-    shader->setVec4f("uBorderSize", layout_.border);
-    shader->setVec4f("uBorderRadii", layout_.borderRadius);
-    shader->setVec2f("uResolution", glm::vec2{transform_.scale.x, transform_.scale.y});
+    const renderer::Uniforms& uniforms = renderer::Uniforms::get();
+    shader->setMat4f(uniforms.modelMat, transform_.modelMatrix);
+    shader->setVec4f(uniforms.color, color_);
+    shader->setVec4f(uniforms.borderColor, borderColor_);
+    shader->setVec4f(uniforms.borderSize, layout_.border);
+    shader->setVec4f(uniforms.borderRadii, layout_.borderRadius);
+    shader->setVec2f(uniforms.resolution, glm::vec2{transform_.scale.x, transform_.scale.y});
+}
+
+bool RecycleList::setInstanceAttributes(renderer::RectInstanceData& data)
+{
+    return fillRectInstance(data, color_, borderColor_);
 }
 
 void RecycleList::onLayoutDirtyPost()
 {
-    removeAll();
+    internals_.elementsCount = itemProvider_ ? providedItemCount_ : listItems_.size();
+    const int32_t neededRows = std::clamp(internals_.elementsCount - internals_.topOfListIdx, 0,
+        internals_.visibleNodes);
+
+    /* Only what's about to be shown gets fetched. Never shrunk so the strings keep their storage. */
+    if (itemProvider_ && neededRows > 0)
+    {
+        if ((int32_t)providedItems_.size() < neededRows) { providedItems_.resize(neededRows); }
+        itemProvider_(internals_.topOfListIdx, std::span{providedItems_.data(), (std::size_t)neededRows});
+    }
+
+    /* Tree only changes when the number of visible rows does. Plain scrolling just rebinds the rows below. */
+    for (int32_t i = rowPool_.size(); i < neededRows; i++)
+    {
+        rowPool_.emplace_back(makeRow(i));
+    }
+    for (; attachedRows_ < neededRows; attachedRows_++)
+    {
+        append(rowPool_[attachedRows_]);
+    }
+    for (; attachedRows_ > neededRows; attachedRows_--)
+    {
+        remove(rowPool_[attachedRows_ - 1]->getId());
+    }
 
-    internals_.elementsCount = listItems_.size();
-    for (int32_t i = 0; i < internals_.visibleNodes; i++)
+    for (int32_t i = 0; i < neededRows; i++)
     {
-        int32_t index = internals_.topOfListIdx + i;
-        if (index >= internals_.elementsCount) { break; }
+        const node::utils::ListItem& item = itemProvider_
+            ? providedItems_[i]
+            : listItems_[internals_.topOfListIdx + i];
+        rowPool_[i]->setColor(item.color)
+            .setText(item.text);
+    }
+}
+
+ButtonPtr RecycleList::makeRow(const int32_t rowIdx)
+{
+    ButtonPtr row = Utils::make<Button>("Item");
+    applyItemLayout(row);
 
-        auto ref = std::make_shared<Button>("Item");
-        ref->setColor(listItems_[index].color)
-            .setText(listItems_[index].text);
+    /* Row shows whatever item is rowIdx positions below the top of the list at the time of the click. */
+    row->getEvents().listen<events::LMBRelease>(
+        [this, rowIdx](const auto&)
+        {
+            const int32_t index = internals_.topOfListIdx + rowIdx;
+            const int32_t itemCount = itemProvider_ ? providedItemCount_ : listItems_.size();
+            if (rowIdx >= attachedRows_ || index >= itemCount) { return; }
 
-        ref->getLayout()
-            .setMargin(itemMargin_)
-            .setBorder(itemBorder_)
-            .setNewScale(itemScale_);
+            internals_.isDirty = true;
+            MAKE_LAYOUT_DIRTY_AND_REQUEST_NEW_FRAME;
 
-        append(ref);
+            node::utils::ListItem* item = itemProvider_ ? &providedItems_[rowIdx] : &listItems_[index];
+            events::LMBItemRelease evt{item, index};
+            getEvents().notifyEvent<events::LMBItemRelease>(evt);
+        });
+    return row;
+}
 
-        ref->getEvents().listen<events::LMBRelease>(
-            [this, index](const auto&)
-            {
-                internals_.isDirty = true;
-                MAKE_LAYOUT_DIRTY_AND_REQUEST_NEW_FRAME;
+void RecycleList::applyItemLayout(const ButtonPtr& row)
+{
+    row->getLayout()
+        .setMargin(itemMargin_)
+        .setBorder(itemBorder_)
+        .setNewScale(itemScale_);
+}
 
-                events::LMBItemRelease evt{&listItems_[index]};
-                getEvents().notifyEvent<events::LMBItemRelease>(evt);
-            });
-    }
+bool RecycleList::warnIfProvided(const char* funcName)
+{
+    if (!itemProvider_) { return false; }
+
+    log_.warnLn("%s ignored, items come from a data source. Use setItemCount or invalidateItems instead.", funcName);
+    return true;
 }
 
 RecycleList& RecycleList::setColor(const glm::vec4& color)
@@ -117,6 +233,7 @@ RecycleList& RecycleList::setBorderColor(const glm::vec4& color)
 RecycleList& RecycleList::setItemScale(const Layout::ScaleXY newScale)
 {
     itemScale_ = newScale;
+    for (const ButtonPtr& row : rowPool_) { applyItemLayout(row); }
     internals_.isDirty = true;
     MAKE_LAYOUT_DIRTY_AND_REQUEST_NEW_FRAME;
     return *this;
@@ -125,6 +242,7 @@ RecycleList& RecycleList::setItemScale(const Layout::ScaleXY newScale)
 RecycleList& RecycleList::setItemMargin(const utils::Layout::TBLR margin)
 {
     itemMargin_ = margin;
+    for (const ButtonPtr& row : rowPool_) { applyItemLayout(row); }
     internals_.isDirty = true;
     MAKE_LAYOUT_DIRTY_AND_REQUEST_NEW_FRAME;
     return *this;
@@ -133,6 +251,7 @@ RecycleList& RecycleList::setItemMargin(const utils::Layout::TBLR margin)
 RecycleList& RecycleList::setItemBorder(const utils::Layout::TBLR border)
 {
     itemBorder_ = border;
+    for (const ButtonPtr& row : rowPool_) { applyItemLayout(row); }
     internals_.isDirty = true;
     MAKE_LAYOUT_DIRTY_AND_REQUEST_NEW_FRAME;
     return *this;
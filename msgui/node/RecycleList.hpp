@@ -2,6 +2,7 @@
 
 #include "msgui/node/AbstractNode.hpp"
 #include "msgui/node/Box.hpp"
+#include "msgui/node/Button.hpp"
 #include "msgui/node/utils/ListItem.hpp"
 
 namespace msgui
@@ -25,6 +26,13 @@ public:
     */
     void addItem(const node::utils::ListItem& item);
 
+    /**
+        Adds many items to the list at once.
+
+        @param items Items to be added
+    */
+    void addItems(const std::vector<node::utils::ListItem>& items);
+
     /**
         Removes the item located at a specified index.
 
@@ -39,6 +47,38 @@ public:
     */
     void removeItemsBy(const std::function<bool(const node::utils::ListItem&)> pred);
 
+    /**
+        Let a data source provide the items instead of owning them. Only the visible items are ever fetched, each
+        time the list scrolls or they get invalidated. Owned items are dropped.
+
+        @param itemCount Number of items the source has
+        @param fetch Callback filling in the item at an index
+    */
+    void setItemProvider(const int32_t itemCount, const node::utils::ListItemFetchFunc& fetch);
+
+    /**
+        Same as setItemProvider but all visible items are fetched with a single call.
+
+        @param itemCount Number of items the source has
+        @param fetchBatch Callback filling in a range of consecutive items
+    */
+    void setBatchItemProvider(const int32_t itemCount, const node::utils::ListItemBatchFetchFunc& fetchBatch);
+
+    /**
+        Change the number of items the data source has.
+
+        @param itemCount New number of items
+    */
+    void setItemCount(const int32_t itemCount);
+
+    /**
+        Notify the list that some of the data source's items changed. They get fetched again if visible.
+
+        @param firstIdx Index of the first changed item
+        @param count Number of changed items
+    */
+    void invalidateItems(const int32_t firstIdx, const int32_t count);
+
     RecycleList& setColor(const glm::vec4& color);
     RecycleList& setBorderColor(const glm::vec4& color);
     RecycleList& setItemScale(const Layout::ScaleXY scale);
@@ -61,6 +101,10 @@ private: // friend
 
 private:
     void setShaderAttributes() override;
+    bool setInstanceAttributes(renderer::RectInstanceData& data) override;
+    ButtonPtr makeRow(const int32_t rowIdx);
+    bool warnIfProvided(const char* funcName);
+    void applyItemLayout(const ButtonPtr& row);
 
 private:
     glm::vec4 color_{1.0f};
@@ -71,6 +115,16 @@ private:
     Layout::TBLR itemBorderRadius_{0};
     std::vector<node::utils::ListItem> listItems_;
 
+    /* Data source mode. Visible items are fetched into providedItems_, reused from one fetch to the next. */
+    node::utils::ListItemBatchFetchFunc itemProvider_{nullptr};
+    int32_t providedItemCount_{0};
+    std::vector<node::utils::ListItem> providedItems_;
+
+    /* Row nodes are created once and then rebound to whatever items are visible. Only the first attachedRows_
+       of them are appended, the rest wait detached until the list needs more rows again. */
+    std::vector<ButtonPtr> rowPool_;
+    int32_t attachedRows_{0};
+
     struct Internals
     {
         bool isDirty{true};
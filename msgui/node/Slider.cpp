@@ -9,6 +9,7 @@
 #include "msgui/layoutEngine/utils/LayoutData.hpp"
 #include "msgui/loaders/MeshLoader.hpp"
 #include "msgui/loaders/ShaderLoader.hpp"
+#include "msgui/renderer/Uniforms.hpp"
 #include "msgui/node/AbstractNode.hpp"
 #include "msgui/node/FrameState.hpp"
 #include "msgui/node/TextLabel.hpp"
@@ -34,7 +35,7 @@ Slider::Slider(const std::string& name)
         return std::to_string(int32_t(val));
     };
 
-    knobNode_ = std::make_shared<SliderKnob>("Knob");
+    knobNode_ = Utils::make<SliderKnob>("Knob");
     knobNode_->setColor(Utils::hexToVec4("#ee0000ff"));
     knobNode_->getLayout()
         .setNewScale({20_px, 1.0_rel});
@@ -46,6 +47,8 @@ Slider::Slider(const std::string& name)
     /* Register only the events you need. */
     getEvents().listen<events::WheelScroll, events::InputChannel>(
         std::bind(&Slider::onMouseWheel, this, std::placeholders::_1));
+    getEvents().listen<events::WheelScroll, events::BubbleChannel>(
+        std::bind(&Slider::onMouseWheel, this, std::placeholders::_1));
     getEvents().listen<events::LMBClick, events::InputChannel>(
         std::bind(&Slider::onMouseClick, this, std::placeholders::_1));
     getEvents().listen<events::LMBDrag, events::InputChannel>(
@@ -62,12 +65,18 @@ void Slider::setShaderAttributes()
 {
     transform_.computeModelMatrix();
     auto shader = getShader();
-    shader->setMat4f("uModelMat", transform_.modelMatrix);
-    shader->setVec4f("uColor", color_);
-    shader->setVec4f("uBorderColor", borderColor_);
-    shader->setVec4f("uBorderSize", layout_.border);
-    shader->setVec4f("uBorderRadii", layout_.borderRadius);
-    shader->setVec2f("uResolution", glm::vec2{transform_.scale.x, transform_.scale.y});
+    const renderer::Uniforms& uniforms = renderer::Uniforms::get();
+    shader->setMat4f(uniforms.modelMat, transform_.modelMatrix);
+    shader->setVec4f(uniforms.color, color_);
+    shader->setVec4f(uniforms.borderColor, borderColor_);
+    shader->setVec4f(uniforms.borderSize, layout_.border);
+    shader->setVec4f(uniforms.borderRadii, layout_.borderRadius);
+    shader->setVec2f(uniforms.resolution, glm::vec2{transform_.scale.x, transform_.scale.y});
+}
+
+bool Slider::setInstanceAttributes(renderer::RectInstanceData& data)
+{
+    return fillRectInstance(data, color_, borderColor_);
 }
 
 void Slider::updateSliderValue()
@@ -112,6 +121,7 @@ void Slider::onMouseWheel(const events::WheelScroll& evt)
 
     events::Scroll scrollEv{slideValue_};
     getEvents().notifyAllChannels<events::Scroll>(scrollEv);
+    evt.stopPropagation();
 }
 
 void Slider::onMouseClick(const events::LMBClick&)
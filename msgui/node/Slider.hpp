@@ -42,6 +42,7 @@ public:
 
 private:
     void setShaderAttributes() override;
+    bool setInstanceAttributes(renderer::RectInstanceData& data) override;
     void updateSliderValue();
     void updateTextValue();
     void setupLayoutReloadables();
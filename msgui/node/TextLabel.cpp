@@ -4,6 +4,7 @@
 
 #include "msgui/loaders/MeshLoader.hpp"
 #include "msgui/loaders/ShaderLoader.hpp"
+#include "msgui/renderer/Uniforms.hpp"
 #include "msgui/Utils.hpp"
 #include "msgui/loaders/FontLoader.hpp"
 #include "msgui/node/FrameState.hpp"
@@ -21,8 +22,6 @@ TextLabel::TextLabel(const std::string& name)
     setShader(loaders::ShaderLoader::loadShader("assets/shader/sdfRect.glsl"));
     setMesh(loaders::MeshLoader::loadQuad());
 
-    setupLayoutReloadables();
-
     /* Defaults */
     color_ = Utils::hexToVec4("#ad0f0f00");
 
@@ -43,31 +42,19 @@ void TextLabel::setShaderAttributes()
 {
     transform_.computeModelMatrix();
     auto shader = getShader();
-
-    shader->setMat4f("uModelMat", transform_.modelMatrix);
-    shader->setVec4f("uColor", color_);
-    shader->setVec4f("uBorderColor", borderColor_);
-    shader->setVec4f("uBorderSize", layout_.border);
-    shader->setVec4f("uBorderRadii", layout_.borderRadius);
-    shader->setVec2f("uResolution", glm::vec2{transform_.scale.x, transform_.scale.y});
+    const renderer::Uniforms& uniforms = renderer::Uniforms::get();
+
+    shader->setMat4f(uniforms.modelMat, transform_.modelMatrix);
+    shader->setVec4f(uniforms.color, color_);
+    shader->setVec4f(uniforms.borderColor, borderColor_);
+    shader->setVec4f(uniforms.borderSize, layout_.border);
+    shader->setVec4f(uniforms.borderRadii, layout_.borderRadius);
+    shader->setVec2f(uniforms.resolution, glm::vec2{transform_.scale.x, transform_.scale.y});
 }
 
-void TextLabel::setupLayoutReloadables()
+bool TextLabel::setInstanceAttributes(renderer::RectInstanceData& data)
 {
-    auto updateCb = [this](){ MAKE_LAYOUT_DIRTY_AND_REQUEST_NEW_FRAME };
-
-    /* Layout will auto recalculate and new frame will be requested on layout data changes. */
-    layout_.onMarginChange = updateCb;
-    layout_.onPaddingChange = updateCb;
-    layout_.onBorderChange = updateCb;
-    layout_.onBorderRadiusChange = updateCb;
-    layout_.onAlignSelfChange = updateCb;
-    layout_.onScaleTypeChange = updateCb;
-    layout_.onGridPosRCChange = updateCb;
-    layout_.onGridSpanRCChange = updateCb;
-    layout_.onScaleChange = updateCb;
-    layout_.onMinScaleChange = updateCb;
-    layout_.onMaxScaleChange = updateCb;
+    return fillRectInstance(data, color_, borderColor_);
 }
 
 TextLabel& TextLabel::setColor(const glm::vec4& color)
@@ -91,7 +78,7 @@ TextLabel& TextLabel::setFont(const std::string fontPath)
 {
     const int32_t previousFontSize = textData_.value()->fontData->fontSize;
     const auto loadedFont = FontLoader::get().loadFont(fontPath, previousFontSize);
-    if (!loadedFont->texId) { return *this; }
+    if (!loadedFont->isLoaded) { return *this; }
 
     textData_.value()->fontData = loadedFont;
     textData_.value()->isDirty = true;
@@ -104,7 +91,7 @@ TextLabel& TextLabel::setFontSize(const int32_t fontSize)
 {
     const std::string previousFontPath = textData_.value()->fontData->fontPath;
     const auto loadedFont = FontLoader::get().loadFont(previousFontPath, fontSize);
-    if (!loadedFont->texId) { return *this; }
+    if (!loadedFont->isLoaded) { return *this; }
 
     textData_.value()->fontData = loadedFont;
     textData_.value()->isDirty = true;
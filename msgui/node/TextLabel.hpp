@@ -27,8 +27,7 @@ public:
 
 private:
     void setShaderAttributes() override;
-
-    void setupLayoutReloadables();
+    bool setInstanceAttributes(renderer::RectInstanceData& data) override;
 
 private:
     glm::vec4 color_{1.0f};
@@ -3,9 +3,12 @@
 #include <algorithm>
 #include <ranges>
 #include <stack>
+#include <thread>
 
+#include "msgui/loaders/BELoadingQueue.hpp"
 #include "msgui/loaders/MeshLoader.hpp"
 #include "msgui/loaders/ShaderLoader.hpp"
+#include "msgui/renderer/Uniforms.hpp"
 #include "msgui/node/AbstractNode.hpp"
 #include "msgui/node/Button.hpp"
 #include "msgui/node/FrameState.hpp"
@@ -15,6 +18,51 @@
 
 namespace msgui
 {
+namespace
+{
+/* Recount a tree from scratch, fixing up depths and indices along the way. Items are first listed depth first, then
+   counted in reverse order so sub items are always counted before their parent.
+
+   depth 0:            a        b
+   depth 1:         c    d
+   depth 2:      e
+
+   Listed as: b a d e c, counted as: c e d a b
+*/
+void recountTree(TreeItem* top)
+{
+    std::vector<TreeItem*> listedItems;
+    std::stack<TreeItem*> traversalStack;
+    traversalStack.push(top);
+    while (!traversalStack.empty())
+    {
+        TreeItem* currentTreeItem = traversalStack.top();
+        traversalStack.pop();
+        listedItems.push_back(currentTreeItem);
+
+        for (int32_t i = 0; i < (int32_t)currentTreeItem->subItems.size(); i++)
+        {
+            TreeItemPtr& item = currentTreeItem->subItems[i];
+            item->depth = currentTreeItem->depth + 1;
+            item->indexInParent = i;
+            traversalStack.push(item.get());
+        }
+    }
+
+    std::vector<int32_t> counts;
+    for (TreeItem* item : listedItems | std::views::reverse)
+    {
+        counts.clear();
+        for (const TreeItemPtr& subItem : item->subItems)
+        {
+            counts.push_back(subItem->visibleCount);
+        }
+        item->subItemCounts.assign(counts);
+        item->visibleCount = 1 + (item->isOpen ? item->subItemCounts.getTotal() : 0);
+    }
+}
+} // namespace
+
 TreeView::TreeView(const std::string& name) : Box(name)
 {
     /* Defaults */
@@ -27,68 +75,172 @@ TreeView::TreeView(const std::string& name) : Box(name)
     layout_.setAllowOverflow({true, true})
         .setType(Layout::Type::VERTICAL)
         .setNewScale({100_px, 100_px});
+
+    rootItem_ = Utils::make<TreeItem>();
+    rootItem_->depth = -1;
+    rootItem_->isOpen = true;
+
+    workerJob_ = std::make_shared<WorkerJob>(WorkerJob{.owner = this});
 }
 
-void TreeView::addRootItem(const TreeItemPtr& tree)
+TreeView::~TreeView()
 {
-    treeItems_.emplace_back(tree);
+    /* Workers are detached and hold on to the items they use, so there's nothing to wait for. Publish tasks still
+       queued or pushed later on find no owner. */
+    workerJob_->owner = nullptr;
+}
 
-    refreshTree();
+void TreeView::addRootItem(const TreeItemPtr& tree)
+{
+    pendingRootItems_.push_back(tree);
+    startRecount();
 }
 
 void TreeView::refreshTree()
 {
-    //TODO: On bigger lists this traversal shall be handled by a separate working thread as to not block the main one.
+    isFullRecountRequested_ = true;
+    startRecount();
+}
 
-    /* Traverse the tree depth first so that at the end we get a contiguous array of open tree items
-       that we can operate on an display to the user.
-       Example & assume each node is opened:
+void TreeView::startRecount()
+{
+    /* Whatever gets requested while a recount runs is picked up once it's published. */
+    if (isRecountRunning_) { return; }
+    if (pendingRootItems_.empty() && !isFullRecountRequested_) { return; }
+
+    /* New root items aren't reachable from the UI yet, so only a full recount needs to freeze the rows. */
+    isRecountRunning_ = true;
+    isTreeFrozen_ = isFullRecountRequested_;
+    isFullRecountRequested_ = false;
+
+    TreeItemPtrVec newRootItems = std::move(pendingRootItems_);
+    pendingRootItems_.clear();
+    std::thread(
+        [job = workerJob_, rootItem = isTreeFrozen_ ? rootItem_ : nullptr, newRootItems = std::move(newRootItems)]()
+        {
+            for (const TreeItemPtr& item : newRootItems)
+            {
+                item->depth = 0;
+                recountTree(item.get());
+            }
+            if (rootItem) { recountTree(rootItem.get()); }
 
-       depth 0:            a        b
-       depth 1:         c    d
-       depth 2:      e
+            loaders::BELoadingQueue::get().pushTask(loaders::VoidTask(
+                [job, newRootItems]()
+                {
+                    if (job->owner) { job->owner->publishRecount(newRootItems); }
+                }));
+        }).detach();
+}
 
-       Then the flattened buffer will be: a c d e b
+void TreeView::publishRecount(const TreeItemPtrVec& countedRootItems)
+{
+    for (TreeItemPtr item : countedRootItems)
+    {
+        rootItem_->addItem(item);
+    }
 
-       -- a
-          -- c
-          -- d
-             -- e
-       -- b
-    */
-    flattenedTreeBuffer.clear();
+    isRecountRunning_ = false;
+    isTreeFrozen_ = false;
+    internals_.isDirty = true;
+    MAKE_LAYOUT_DIRTY_AND_REQUEST_NEW_FRAME;
 
-    std::stack<TreeItemPtr> traversalStack;
-    for (auto& item : treeItems_ | std::views::reverse)
+    /* Children that arrived while the tree was being counted. */
+    for (const auto& [item, children] : pendingChildren_)
     {
-        traversalStack.push(item);
+        publishChildren(item, children);
     }
+    pendingChildren_.clear();
 
-    internals_.maxDepth_ = 0;
-    while (!traversalStack.empty())
+    startRecount();
+}
+
+void TreeView::loadChildren(const TreeItemPtr& item)
+{
+    /* Fetched only once, whatever comes back is what the item has from now on. */
+    item->hasLazyChildren = false;
+    if (!childrenProvider_)
     {
-        TreeItemPtr currentTreeItem = traversalStack.top();
-        traversalStack.pop();
+        log_.warnLn("Item has lazy children but no children provider is set.");
+        return;
+    }
 
-        flattenedTreeBuffer.push_back(currentTreeItem);
+    if (!isChildrenFetchAsync_)
+    {
+        const TreeItemPtrVec children = childrenProvider_(item);
+        for (const TreeItemPtr& child : children)
+        {
+            child->depth = item->depth + 1;
+            recountTree(child.get());
+        }
+        publishChildren(item, children);
+        return;
+    }
 
-        /* Reverse needed because otherwise children will be displayed in reverse order due to how
-           stack traversal works.*/
-        for (auto& item : currentTreeItem->subItems | std::views::reverse)
+    TreeItemPtr loadingItem = Utils::make<TreeItem>();
+    loadingItem->color = item->color;
+    loadingItem->text = loadingText_;
+    loadingItem->isPlaceholder = true;
+    item->addItem(loadingItem);
+
+    /* Item itself stays on the UI thread, a recount might be writing it too. The provider gets a detached copy of
+       its payload instead. */
+    TreeItemPtr snapshot = Utils::make<TreeItem>();
+    snapshot->color = item->color;
+    snapshot->text = item->text;
+    snapshot->depth = item->depth;
+
+    /* Fetched children are counted on the worker too, they might come with sub items of their own. */
+    std::thread(
+        [job = workerJob_, provider = childrenProvider_, item, snapshot = std::move(snapshot)]()
         {
-            if (currentTreeItem->isOpen)
+            TreeItemPtrVec children = provider(snapshot);
+            for (const TreeItemPtr& child : children)
             {
-                internals_.maxDepth_ = std::max(internals_.maxDepth_, item->depth);
-                traversalStack.push(item);
+                child->depth = snapshot->depth + 1;
+                recountTree(child.get());
             }
-        }
+
+            loaders::BELoadingQueue::get().pushTask(loaders::VoidTask(
+                [job, item, children = std::move(children)]()
+                {
+                    if (job->owner) { job->owner->publishChildren(item, children); }
+                }));
+        }).detach();
+}
+
+void TreeView::publishChildren(const TreeItemPtr& item, const TreeItemPtrVec& children)
+{
+    /* The worker is reading the tree, attach once it's done. */
+    if (isTreeFrozen_)
+    {
+        pendingChildren_.emplace_back(item, children);
+        return;
     }
+
+    /* Drops the loading row, if any. */
+    item->removeItems();
+    for (TreeItemPtr child : children)
+    {
+        item->addItem(child);
+    }
+
+    internals_.isDirty = true;
+    MAKE_LAYOUT_DIRTY_AND_REQUEST_NEW_FRAME;
 }
 
 void TreeView::printFlatTreeView()
 {
-    for (const auto& item : flattenedTreeBuffer)
+    if (isTreeFrozen_)
     {
+        log_.warnLn("Tree is being refreshed, nothing to print yet.");
+        return;
+    }
+
+    const int32_t rowCount = rootItem_->subItemCounts.getTotal();
+    for (int32_t i = 0; i < rowCount; i++)
+    {
+        const TreeItemPtr item = findVisibleItem(i);
         log_.raw("%*s- depth(%d) col(%.2f %.2f %.2f %.2f)\n", item->depth*4, "", item->depth,
             item->color.r, item->color.g, item->color.b, item->color.a);
     }
@@ -98,50 +250,99 @@ void TreeView::setShaderAttributes()
 {
     transform_.computeModelMatrix();
     auto shader = getShader();
-    shader->setMat4f("uModelMat", transform_.modelMatrix);
-    shader->setVec4f("uColor", color_);
-    shader->setVec4f("uBorderColor", borderColor_);
-    shader->setVec4f("uBorderSize", layout_.border);
-    shader->setVec4f("uBorderRadii", layout_.borderRadius);
-    shader->setVec2f("uResolution", glm::vec2{transform_.scale.x, transform_.scale.y});
+    const renderer::Uniforms& uniforms = renderer::Uniforms::get();
+    shader->setMat4f(uniforms.modelMat, transform_.modelMatrix);
+    shader->setVec4f(uniforms.color, color_);
+    shader->setVec4f(uniforms.borderColor, borderColor_);
+    shader->setVec4f(uniforms.borderSize, layout_.border);
+    shader->setVec4f(uniforms.borderRadii, layout_.borderRadius);
+    shader->setVec2f(uniforms.resolution, glm::vec2{transform_.scale.x, transform_.scale.y});
+}
+
+bool TreeView::setInstanceAttributes(renderer::RectInstanceData& data)
+{
+    return fillRectInstance(data, color_, borderColor_);
+}
+
+TreeItemPtr TreeView::findVisibleItem(int32_t idx) const
+{
+    /* Each level skips the sub items whose rows all come before idx. Landing past the start of a sub item means the
+       row is one of its descendants, so keep going down. */
+    const TreeItem* item = rootItem_.get();
+    while (true)
+    {
+        const int32_t subIdx = item->subItemCounts.find(idx);
+        if (subIdx >= (int32_t)item->subItems.size()) { return nullptr; }
+
+        const TreeItemPtr& subItem = item->subItems[subIdx];
+        if (idx == 0) { return subItem; }
+
+        idx--;
+        item = subItem.get();
+    }
 }
 
 void TreeView::onLayoutDirtyPost()
 {
+    /* Items are being written by the worker. Current rows and row count stand in until the refresh gets published. */
+    if (isTreeFrozen_) { return; }
+
     removeAll();
 
-    internals_.elementsCount = flattenedTreeBuffer.size();
+    internals_.elementsCount = rootItem_->subItemCounts.getTotal();
+    internals_.maxDepth_ = 0;
     for (int32_t i = 0; i < internals_.visibleNodes; i++)
     {
         int32_t index = internals_.topOfListIdx + i;
         if (index < internals_.elementsCount)
         {
-            auto ref = std::make_shared<Button>("Item");
-            ref->setColor(flattenedTreeBuffer[index]->color)
-                .setText(flattenedTreeBuffer[index]->text);
+            const TreeItemPtr item = findVisibleItem(index);
+            internals_.maxDepth_ = std::max(internals_.maxDepth_, item->depth);
+
+            auto ref = Utils::make<Button>("Item");
+            ref->setColor(item->color)
+                .setText(item->text);
 
             ref->getLayout()
                 .setMargin(itemMargin_)
                 .setBorder(itemBorder_)
                 .setNewScale(itemScale_);
-            ref->getLayout().margin.left += flattenedTreeBuffer[index]->depth*internals_.marginFactor_;
+            ref->getLayout().margin.left += item->depth*internals_.marginFactor_;
             append(ref);
 
+            /* Toggling only touches the counts of the item, its closed descendants and its parents. */
             ref->getEvents().listen<events::LMBRelease>(
-                [this, index](const auto&)
+                [this, itemRef = TreeItemWPtr(item)](const auto&)
                 {
-                    flattenedTreeBuffer[index]->toggle();
-                    refreshTree();
+                    const TreeItemPtr clickedItem = itemRef.lock();
+                    if (!clickedItem || clickedItem->isPlaceholder || isTreeFrozen_) { return; }
+
+                    /* Opened first, a fetch running on a worker must not race with the item changing. */
+                    clickedItem->toggle();
+                    if (clickedItem->isOpen && clickedItem->hasLazyChildren) { loadChildren(clickedItem); }
                     internals_.isDirty = true;
                     MAKE_LAYOUT_DIRTY_AND_REQUEST_NEW_FRAME;
 
-                    events::LMBTreeItemRelease evt{flattenedTreeBuffer[index]};
+                    events::LMBTreeItemRelease evt{clickedItem};
                     getEvents().notifyEvent<events::LMBTreeItemRelease>(evt);
                 });
         }
     }
 }
 
+TreeView& TreeView::setChildrenProvider(const TreeItemChildrenFetchFunc& provider, const bool isAsync)
+{
+    childrenProvider_ = provider;
+    isChildrenFetchAsync_ = isAsync;
+    return *this;
+}
+
+TreeView& TreeView::setLoadingText(const std::string& text)
+{
+    loadingText_ = text;
+    return *this;
+}
+
 TreeView& TreeView::setColor(const glm::vec4& color)
 {
     color_ = color;
@@ -196,6 +397,8 @@ TreeView& TreeView::setMarginFactor(const uint32_t marginFactor)
     return *this;
 }
 
+std::string TreeView::getLoadingText() const { return loadingText_; }
+
 glm::vec4 TreeView::getColor() const { return color_; }
 
 glm::vec4 TreeView::getBorderColor() const { return borderColor_; }
@@ -15,16 +15,22 @@ class TreeView : public Box
 struct Internals;
 public:
     TreeView(const std::string& name);
+    ~TreeView();
 
     /**
-        Adds a new tree item to the internal buffer.
+        Adds a new tree item to the internal buffer. The item's tree gets counted on a worker thread and only shows
+        up once that's done, the current rows stay usable in the meantime. The item's tree shall not be changed
+        until then.
 
         @param tree Tree item to be added
     */
     void addRootItem(const TreeItemPtr& tree);
 
     /**
-        Triggers refresh of the viewable tree in order to have the newest changes visible.
+        Triggers refresh of the viewable tree in order to have the newest changes visible. Opening, closing or adding
+        items through TreeItem keeps the tree up to date on its own, a full refresh is only needed after changing
+        items by hand (isOpen, subItems). Refreshing runs on a worker thread, the rows shown before stay on screen
+        but don't react until it's done. Items shall not be changed in the meantime.
     */
     void refreshTree();
 
@@ -47,6 +53,17 @@ public:
     */
     void removeItemsBy(const std::function<bool(const glm::vec4&)> pred);
 
+    /**
+        Set the function fetching sub items of items marked with hasLazyChildren. It's called the first time such an
+        item gets opened from the view, only once per item.
+
+        @param provider Function returning the sub items of an item
+        @param isAsync Fetch on a worker thread, showing a loading row under the item until the sub items arrive
+
+        @return Self
+    */
+    TreeView& setChildrenProvider(const TreeItemChildrenFetchFunc& provider, const bool isAsync = false);
+    TreeView& setLoadingText(const std::string& text);
     TreeView& setColor(const glm::vec4& color);
     TreeView& setBorderColor(const glm::vec4& color);
     TreeView& setItemScale(const Layout::ScaleXY scale);
@@ -55,6 +72,7 @@ public:
     TreeView& setItemBorderRadius(const utils::Layout::TBLR borderRadius);
     TreeView& setMarginFactor(const uint32_t marginFactor);
     
+    std::string getLoadingText() const;
     glm::vec4 getColor() const;
     glm::vec4 getBorderColor() const;
     Layout::ScaleXY getItemScale() const;
@@ -74,6 +92,12 @@ private:
 
 private:
     void setShaderAttributes() override;
+    bool setInstanceAttributes(renderer::RectInstanceData& data) override;
+    TreeItemPtr findVisibleItem(int32_t idx) const;
+    void startRecount();
+    void publishRecount(const TreeItemPtrVec& countedRootItems);
+    void loadChildren(const TreeItemPtr& item);
+    void publishChildren(const TreeItemPtr& item, const TreeItemPtrVec& children);
 
 private:
     glm::vec4 color_{1.0f};
@@ -83,8 +107,26 @@ private:
     utils::Layout::TBLR itemBorder_{0};
     utils::Layout::TBLR itemBorderRadius_{0};
 
-    TreeItemPtrVec treeItems_;
-    TreeItemPtrVec flattenedTreeBuffer; //TODO: Consider using a list instead
+    /* Hidden, always open parent of the root items. Rows are never flattened, the visible counts kept by the items
+       let any row index be found by descending from here. */
+    TreeItemPtr rootItem_{nullptr};
+
+    /* Recounting and fetching children run on detached workers and get published back through the BELoadingQueue.
+       The job outlives us while workers or publish tasks are around, it tells them if there's anyone to publish to. */
+    struct WorkerJob
+    {
+        TreeView* owner{nullptr};
+    };
+    std::shared_ptr<WorkerJob> workerJob_{nullptr};
+    TreeItemPtrVec pendingRootItems_;
+    bool isRecountRunning_{false};
+    bool isFullRecountRequested_{false};
+    bool isTreeFrozen_{false};
+
+    TreeItemChildrenFetchFunc childrenProvider_{nullptr};
+    bool isChildrenFetchAsync_{false};
+    std::string loadingText_{"Loading..."};
+    std::vector<std::pair<TreeItemPtr, TreeItemPtrVec>> pendingChildren_;
 
     struct Internals
     {
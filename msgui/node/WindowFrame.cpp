@@ -6,11 +6,12 @@
 
 #include <algorithm>
 #include <memory>
-#include <queue>
 #include <ranges>
 
 #include <GLFW/glfw3.h>
 
+#include "msgui/loaders/FontLoader.hpp"
+
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 // #include "msgui/layoutEngine/BasicLayoutEngine.hpp"
 #include "msgui/layoutEngine/BasicTextLayoutEngine.hpp"
@@ -25,7 +26,6 @@
 #include "msgui/events/NodeEventManager.hpp"
 #include "msgui/events/RMBRelease.hpp"
 #include "msgui/events/WheelScroll.hpp"
-#include "msgui/renderer/NodeRenderer.hpp"
 #include "msgui/renderer/TextBufferStore.hpp"
 #include "msgui/vendor/stb_image_write.h"
 
@@ -42,7 +42,7 @@ WindowFrame::WindowFrame(const std::string& windowName, const uint32_t width, co
     // , layoutEngine_(std::make_shared<BasicLayoutEngine>())
     , layoutEngine_(std::make_shared<CustomLayoutEngine>())
     , textLayoutEngine_(std::make_shared<BasicTextLayoutEngine>())
-    , frameBox_(std::make_shared<Box>(windowName))
+    , frameBox_(Utils::make<Box>(windowName))
     , isPrimary_(isPrimary)
 {
     /* Setup GLFW input events */
@@ -99,6 +99,8 @@ WindowFrame::WindowFrame(const std::string& windowName, const uint32_t width, co
         width - frameBox_->getLayout().border.left - frameBox_->getLayout().border.left,
         height - frameBox_->getLayout().border.top - frameBox_->getLayout().border.bot};
     frameBox_->state_ = frameState_;
+    nodeStore_.insert(frameBox_, 0);
+    propagationPath_.reserve(PROPAGATION_PATH_RESERVE);
 
     /* Init cursors */
     if (initCursors)
@@ -120,9 +122,9 @@ WindowFrame::WindowFrame(const std::string& windowName, const uint32_t width, co
 WindowFrame::~WindowFrame()
 {
     log_.infoLn("Cleaning up frameState..");
-    frameState_->clickedNodePtr = NO_PTR;
-    frameState_->prevClickedNodePtr = NO_PTR;
-    frameState_->hoveredNodePtr = NO_PTR;
+    frameState_->clickedNode = NO_HANDLE;
+    frameState_->prevClickedNode = NO_HANDLE;
+    frameState_->hoveredNode = NO_HANDLE;
 
     if (!initCursors)
     {
@@ -171,6 +173,16 @@ bool WindowFrame::isPrimary() const
     return isPrimary_;
 }
 
+const renderer::RenderStats& WindowFrame::getRenderStats() const
+{
+    return renderStats_;
+}
+
+const Window& WindowFrame::getWindow() const
+{
+    return window_;
+}
+
 bool WindowFrame::run()
 {
     /* See if cursor needs changing */
@@ -184,6 +196,10 @@ bool WindowFrame::run()
     /* Layout pass */
     if (frameState_->layoutPassActions != ELayoutPass::NOTHING)
     {
+        /* Nodes might move around during layout so there's no telling which areas got damaged. Retained draw
+           commands are outdated as well. */
+        frameState_->damageArea.addFull();
+        rectRenderer_.invalidate();
         updateLayout();
 
         /* If the layout got dirty again we need to simulate a new frame RUN request. */
@@ -197,9 +213,6 @@ bool WindowFrame::run()
     /* Render pass */
     window_.setContextCurrent();
     window_.setCurrentViewport();
-    window_.setCurrentScissorArea();
-    Window::clearColor(glm::vec4{0.0, 1.0, 0.0, 1.0f});
-    Window::clearBits(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     renderLayout();
     window_.swap();
 
@@ -209,25 +222,49 @@ bool WindowFrame::run()
 void WindowFrame::renderLayout()
 {
     const auto pMat = window_.getProjectionMat();
+    const auto& frameSize = frameState_->frameSize;
+    auto& damageArea = frameState_->damageArea;
+
+    /* Previous frame contents are lost if the offscreen storage had to be recreated (first frame, resize). */
+    if (offscreenBuffer_.resize(frameSize))
+    {
+        damageArea.addFull();
+    }
+
+    offscreenBuffer_.bind();
+    renderStats_ = renderer::RenderStats{};
 
-    /* Currently we render front to back to minimize overdraw by making use of the depth buffer.
-       Not sure how this will work when we need alpha blending between nodes. Maybe we will need
-       to render back to front in that case and take overdrawing as a compromise. */
-    /* TODO: Deal with transparent objects. Current fix is to render back to front (reverse) when there are
-       transparent objects. */
-    // Later Note: for UI apps it may really not matter performance wise to render front to back.
-    for (auto& node : allFrameChildNodes_ | std::views::reverse) // -> back to front Z
-    // for (auto& node : allFrameChildNodes_) // -> front to back Z
+    /* Only the damaged area gets cleared and redrawn, everything else is kept from the previous frames. */
+    if (!damageArea.isEmpty())
     {
-        renderer::NodeRenderer::render(node, pMat, frameState_->frameSize.y);
+        damageArea.isFull
+            ? window_.setCurrentScissorArea()
+            : Window::setScissorArea(damageArea.min.x, frameSize.y - damageArea.max.y,
+                damageArea.max.x - damageArea.min.x, damageArea.max.y - damageArea.min.y);
+        Window::clearColor(glm::vec4{0.0, 1.0, 0.0, 1.0f});
+        Window::clearBits(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        /* Nodes are rendered back to front Z. Consecutive nodes sharing the sdfRect shader get batched into
+           instanced draw calls, everything else is drawn one by one in between batches. */
+        rectRenderer_.render(nodeStore_, pMat, damageArea);
+
+        /* Render text after the nodes themselves. */
+        textRenderer_.render(pMat, damageArea);
+
+        /* Metrics */
+        renderStats_ = rectRenderer_.getStats();
+        renderStats_.drawCalls += textRenderer_.getBatchCount();
     }
+    damageArea.reset();
 
-    /* Render text after the nodes themselves. */
-    textRenderer_.render(pMat, frameState_->frameSize.y);
+    offscreenBuffer_.blitToScreen();
 }
 
 void WindowFrame::updateLayout()
 {
+    /* Viewable areas or the nodes themselves are about to change. */
+    isHitTestGridDirty_ = true;
+
     /* Must redo internal vector structure if something was added/removed. */
     if (frameState_->layoutPassActions & ELayoutPass::RESOLVE_NODE_RELATIONS)
     {
@@ -243,97 +280,299 @@ void WindowFrame::updateLayout()
             can SET the variable to true again if it decides the layout got dirty. */
         frameState_->layoutPassActions &= ~ELayoutPass::RECALCULATE_NODE_TRANSFORM;
 
-        for (const auto& node : allFrameChildNodes_ | std::views::reverse)
-        {
-            CustomLayoutEngine::Result<CustomLayoutEngine::Void> result= layoutEngine_->process(node);
-            if (!result.error.empty())
-            {
-                log_.errorLn("Error in layout calc while processing '%s': %s", node->getCName(), result.error.c_str());
-                return;
-            }
+        const bool isLayoutOk = layoutPool_ ? layoutNodesParallel() : layoutNodes();
+        if (!isLayoutOk) { return; }
 
-            /* TODO: This shall be moved into layout process(). */
-            /* After updating the node layout, we need to update the viewable area of the node based on the parent's
-               viewable area. Raw parent is used for better performance (compared to locking each time). */
-            if (auto parent = node->getParentRaw())
-            {
-                /* Dropdown's box child needs to ignore using the BB of the parent to compute viewable area. Use
-                   the area of the window itself instead. Also FloatingBox shall be unafected by viewarea. */
-                if (parent->getType() == AbstractNode::NodeType::DROPDOWN
-                || node->getType() == AbstractNode::NodeType::FLOATING_BOX)
-                {
-                    auto frameBoxIdx = allFrameChildNodes_.size() - 1;
-                    node->transform_.computeViewableArea(allFrameChildNodes_[frameBoxIdx]->transform_, utils::Layout::TBLR{0});
-                }
-                /* Otherwise just compute viewable area as normal. */
-                else
-                {
-                    node->transform_.computeViewableArea(parent->transform_, parent->getLayout().border);
-                }
-            }
-        }
+        computeViewableAreas();
     }
 
     /* Update text layouts if needed. */
+    auto& fontLoader = loaders::FontLoader::get();
+    const uint64_t evictionCount = fontLoader.beginGlyphPass();
     auto& textBuffer = renderer::TextBufferStore::get().buffer();
     for (auto& textData : textBuffer)
     {
-        textLayoutEngine_->process(textData, isNodeTrRecalc);
+        textLayoutEngine_->process(textData, false);
+    }
+
+    /* Lazy glyphs evicted during the pass might still be used by texts that didn't need a new layout. Marking all of
+       them dirty lays out the visible ones again right away, and since glyphs used in this pass can't be evicted that
+       gets rid of their stale atlas slots. Invisible texts get skipped by the engine but stay dirty until shown. */
+    if (fontLoader.getEvictionCount() != evictionCount)
+    {
+        for (auto& textData : textBuffer)
+        {
+            textData.isDirty = true;
+            textLayoutEngine_->process(textData, false);
+        }
     }
 }
 
-void WindowFrame::resolveNodeRelations()
+bool WindowFrame::layoutNodes()
+{
+    /* Walked as a tree rather than by depth, scroll nodes can be less deep than their parent but still need to be
+       laid out after it. */
+    return layoutSubtree(frameBox_);
+}
+
+bool WindowFrame::layoutNodesParallel()
 {
-    allFrameChildNodes_.clear();
+    /* A node only depends on its parent being laid out, so every subtree can be done independently once its root
+       got placed. Each subtree task spawns tasks for the subtrees under it and idle workers steal them. */
+    layoutWorkerOutputs_.resize(layoutPool_->getWorkerCount());
+    layoutPool_->push(0, [this](const int32_t workerIdx) { layoutSubtreeTask(frameBox_, workerIdx); });
+    layoutPool_->runAll();
+
+    /* Back on the main thread, things that could not be done concurrently get done now. */
+    bool isLayoutOk = true;
+    for (auto& output : layoutWorkerOutputs_)
+    {
+        isLayoutOk &= !output.hasError;
+        output.hasError = false;
 
-    std::queue<AbstractNodePtr> q;
-    q.push(frameBox_);
+        layoutEngine_->applyPendingOverflows(output.pendingOverflows);
+        for (const auto& node : output.mainThreadNodes)
+        {
+            isLayoutOk &= layoutSubtree(node);
+        }
+        output.mainThreadNodes.clear();
+    }
 
-    while (!q.empty())
+    return isLayoutOk;
+}
+
+void WindowFrame::layoutSubtreeTask(const AbstractNodePtr& node, const int32_t workerIdx)
+{
+    LayoutWorkerOutput& output = layoutWorkerOutputs_[workerIdx];
+    node->hasDirtySubNodes_ = false;
+    if (!layoutNode(node, &output.pendingOverflows))
     {
-        AbstractNodePtr node = q.front();
-        q.pop();
+        output.hasError = true;
+        return;
+    }
 
-        allFrameChildNodes_.push_back(node);
+    for (const auto& ch : node->getChildren())
+    {
+        /* Not part of the frame until the next node relations resolve. */
+        if (!ch->state_ || isSubtreeClean(ch)) { continue; }
 
-        for (auto& ch : node->getChildren())
+        /* These create their items while being processed which can only happen on the main thread. */
+        if (ch->getType() == AbstractNode::NodeType::RECYCLE_LIST || ch->getType() == AbstractNode::NodeType::TREEVIEW)
         {
-            /* Set children's frameState and depth if needed */
-            if (!ch->state_)
-            {
-                bool isScrollNode = ch->getType() == AbstractNode::NodeType::SCROLL;
-                bool isDropdownNodeBox = ch->getType() == AbstractNode::NodeType::DROPDOWN;
-                bool isFloatingBoxNode = ch->getType() == AbstractNode::NodeType::FLOATING_BOX;
-                ch->parent_ = node;
-                ch->parentRaw_ = node.get();
-                ch->transform_.pos.z = node->transform_.pos.z + 1;
-                
-                if (isScrollNode)
-                {
-                    // needs to start from the down and go down progressively
-                    ch->transform_.pos.z = SCROLL_LAYER_START - node->transform_.pos.z;
-                }
-                else if (isDropdownNodeBox)
-                {
-                    ch->transform_.pos.z += DROPDOWN_LAYER_START;
-                }
-                else if (isFloatingBoxNode)
-                {
-                    ch->transform_.pos.z += FLOATING_LAYER_START;
-                }
-                ch->state_ = frameState_;
-            }
+            output.mainThreadNodes.push_back(ch);
+            continue;
+        }
 
-            q.push(ch);
+        /* Leaves are too cheap to be worth a task of their own. */
+        if (ch->getChildren().empty())
+        {
+            output.hasError |= !layoutNode(ch, &output.pendingOverflows);
+            continue;
         }
+
+        layoutPool_->push(workerIdx, [this, ch](const int32_t idx) { layoutSubtreeTask(ch, idx); });
+    }
+}
+
+bool WindowFrame::layoutSubtree(const AbstractNodePtr& node)
+{
+    if (isSubtreeClean(node)) { return true; }
+
+    node->hasDirtySubNodes_ = false;
+    if (!layoutNode(node, nullptr)) { return false; }
+
+    bool isLayoutOk = true;
+    for (const auto& ch : node->getChildren())
+    {
+        if (!ch->state_) { continue; }
+        isLayoutOk &= layoutSubtree(ch);
+    }
+    return isLayoutOk;
+}
+
+bool WindowFrame::isSubtreeClean(const AbstractNodePtr& node) const
+{
+    /* Nothing in there changed and its parent didn't move or resize it, so none of it needs to be walked. */
+    const utils::Transform& tr = node->transform_;
+    return !node->isLayoutDirty_ && !node->hasDirtySubNodes_ && tr.pos == node->laidOutPos_
+        && tr.scale == node->laidOutScale_;
+}
+
+bool WindowFrame::layoutNode(const AbstractNodePtr& node, ILayoutEngine::PendingOverflows* pendingOverflows)
+{
+    /* Only subNodes of nodes that got marked dirty or that got moved/resized by their own parent need to be laid
+       out again. Everything else keeps the transforms computed in previous passes. */
+    utils::Transform& tr = node->transform_;
+    const bool isTrChanged = tr.pos != node->laidOutPos_ || tr.scale != node->laidOutScale_;
+    if (!node->isLayoutDirty_ && !isTrChanged) { return true; }
+
+    /* Process can mark the node dirty again, so clear it beforehand. */
+    node->isLayoutDirty_ = false;
+    node->laidOutPos_ = tr.pos;
+    node->laidOutScale_ = tr.scale;
+
+    /* Border changes dirty the node, so this is the place to keep the inset used by the viewable area pass. */
+    const utils::Layout::TBLR& border = node->getLayout().border;
+    utils::TransformStore::get().clipInset(tr.slot) = glm::ivec4{
+        (int32_t)border.left, (int32_t)border.top, (int32_t)(border.left + border.right),
+        (int32_t)(border.top + border.bot)};
+
+    CustomLayoutEngine::Result<CustomLayoutEngine::Void> result = pendingOverflows
+        ? layoutEngine_->process(node, *pendingOverflows)
+        : layoutEngine_->process(node);
+    if (!result.error.empty())
+    {
+        log_.errorLn("Error in layout calc while processing '%s': %s", node->getCName(), result.error.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+void WindowFrame::computeViewableAreas()
+{
+    viewableAreaBatch_.compute();
+
+    /* Nodes removed while laying out are still part of the batch, keep them hidden. */
+    utils::TransformStore& trStore = utils::TransformStore::get();
+    for (const uint32_t slot : frameState_->detachedSlots)
+    {
+        trStore.vScale(slot) = {0, 0};
     }
+}
 
-    /* Sort nodes from high to low depth */
-    std::ranges::sort(allFrameChildNodes_,
-        [](const AbstractNodePtr a, const AbstractNodePtr b)
+void WindowFrame::setLayoutThreads(const int32_t threadCount)
+{
+    layoutPool_.reset();
+    layoutWorkerOutputs_.clear();
+    if (threadCount <= 1) { return; }
+
+    layoutPool_ = std::make_unique<utils::WorkStealingPool>(threadCount);
+    log_.infoLn("Parallel layout enabled with %d threads", threadCount);
+}
+
+void WindowFrame::resolveNodeRelations()
+{
+    /* Nodes detached from the frame leave the store first. They are kept alive until attaching is done since
+       attached nodes could still point to them as their raw parent. */
+    AbstractNodePVec detachedNodes;
+    for (const uint32_t slot : frameState_->detachedSlots)
+    {
+        if (AbstractNodePtr node = nodeStore_.remove(slot))
         {
-            return a->getTransform().pos.z > b->getTransform().pos.z;
-        });
+            viewableAreaBatch_.remove(slot);
+            detachedNodes.emplace_back(std::move(node));
+        }
+    }
+    frameState_->detachedSlots.clear();
+
+    /* Only the subtrees appended since the last time need to be placed into the store. */
+    for (const auto& node : frameState_->attachedNodes)
+    {
+        /* Skip nodes that got removed in the meantime or that got attached already through another subtree. */
+        AbstractNode* parent = node->parentRaw_;
+        if (node->state_ || !parent || parent->state_ != frameState_) { continue; }
+
+        attachSubtree(nodeStore_.getNode(parent->transform_.slot), node);
+    }
+    frameState_->attachedNodes.clear();
+}
+
+void WindowFrame::attachSubtree(const AbstractNodePtr& parent, const AbstractNodePtr& node)
+{
+    /* Set frameState and depth of the node */
+    const bool isScrollNode = node->getType() == AbstractNode::NodeType::SCROLL;
+    const bool isDropdownNodeBox = node->getType() == AbstractNode::NodeType::DROPDOWN;
+    const bool isFloatingBoxNode = node->getType() == AbstractNode::NodeType::FLOATING_BOX;
+    node->parent_ = parent;
+    node->parentRaw_ = parent.get();
+    node->transform_.pos.z = parent->transform_.pos.z + 1;
+
+    if (isScrollNode)
+    {
+        // needs to start from the down and go down progressively
+        node->transform_.pos.z = SCROLL_LAYER_START - parent->transform_.pos.z;
+    }
+    else if (isDropdownNodeBox)
+    {
+        node->transform_.pos.z += DROPDOWN_LAYER_START;
+    }
+    else if (isFloatingBoxNode)
+    {
+        node->transform_.pos.z += FLOATING_LAYER_START;
+    }
+    node->state_ = frameState_;
+
+    const uint32_t level = nodeStore_.getLevel(parent->transform_.slot) + 1;
+    nodeStore_.insert(node, level);
+
+    /* Dropdown's box child needs to ignore using the BB of the parent to compute viewable area. Use
+       the area of the window itself instead. Also FloatingBox shall be unafected by viewarea. */
+    const bool isFrameBoxBound = parent->getType() == AbstractNode::NodeType::DROPDOWN || isFloatingBoxNode;
+    viewableAreaBatch_.add(level, node->transform_.slot,
+        isFrameBoxBound ? frameBox_->transform_.slot : parent->transform_.slot, isFrameBoxBound);
+
+    for (const auto& ch : node->getChildren())
+    {
+        attachSubtree(node, ch);
+    }
+}
+
+AbstractNode* WindowFrame::findNodeAt(const int32_t x, const int32_t y)
+{
+    /* Grid only gets rebuilt on the first lookup after a layout pass, layout can run many times in between. */
+    if (isHitTestGridDirty_)
+    {
+        isHitTestGridDirty_ = false;
+        hitTestGrid_.rebuild(nodeStore_, frameState_->frameSize);
+    }
+    return hitTestGrid_.findNodeAt(nodeStore_, x, y);
+}
+
+void WindowFrame::buildPropagationPath(AbstractNode* target)
+{
+    /* Ancestors of the target, nearest first. Raw parents can only be trusted while the node is held by the frame,
+       the frame keeps all of its ancestors alive as well. Handles are kept instead of pointers since listeners along
+       the path could destroy nodes. */
+    propagationPath_.clear();
+    if (!nodeStore_.contains(target->getTransform().slot)) { return; }
+
+    for (AbstractNode* p = target->parentRaw_; p != nullptr; p = p->parentRaw_)
+    {
+        propagationPath_.push_back(p->getHandle());
+    }
+}
+
+template<typename T>
+void WindowFrame::propagateEvent(AbstractNode* target, T& evt)
+{
+    NodeRegistry& registry = NodeRegistry::get();
+    const NodeHandle targetHandle = target->getHandle();
+    buildPropagationPath(target);
+
+    for (const NodeHandle handle : propagationPath_ | std::views::reverse)
+    {
+        if (evt.isPropagationStopped) { return; }
+        if (AbstractNode* node = registry.resolve(handle))
+        {
+            node->getEvents().template notifyEvent<T, events::CaptureChannel>(evt);
+        }
+    }
+
+    if (evt.isPropagationStopped) { return; }
+    if (AbstractNode* node = registry.resolve(targetHandle))
+    {
+        node->getEvents().notifyAllChannels(evt);
+    }
+
+    for (const NodeHandle handle : propagationPath_)
+    {
+        if (evt.isPropagationStopped) { return; }
+        if (AbstractNode* node = registry.resolve(handle))
+        {
+            node->getEvents().template notifyEvent<T, events::BubbleChannel>(evt);
+        }
+    }
 }
 
 void WindowFrame::resolveOnMouseButtonFromInput(const int32_t btn, const int32_t action)
@@ -341,86 +580,79 @@ void WindowFrame::resolveOnMouseButtonFromInput(const int32_t btn, const int32_t
     frameState_->mouseButtonState[btn] = action;
     frameState_->lastMouseButtonTriggeredIdx = btn;
 
+    NodeRegistry& registry = NodeRegistry::get();
     int32_t mX{frameState_->mouseX};
     int32_t mY{frameState_->mouseY};
     bool foundNode{false};
-    for (const auto& node : allFrameChildNodes_)
+    if (AbstractNode* node = findNodeAt(mX, mY))
     {
-        /* Skip nodes marked as transparent. Events will be bubbled down to the next valid node. */
-        if (node->isEventTransparent()) { continue; }
-
-        glm::ivec2& nodePos = node->transform_.vPos;
-        glm::ivec2& nodeScale = node->transform_.vScale;
-        if ((mX >= nodePos.x && mX <= nodePos.x + nodeScale.x) &&
-            (mY >= nodePos.y && mY <= nodePos.y + nodeScale.y))
+        foundNode = true;
+        if (frameState_->mouseButtonState[btn])
         {
-            foundNode = true;
-            if (frameState_->mouseButtonState[btn])
+            frameState_->clickedNode = node->getHandle();
+            AbstractNode* prevNode = registry.resolve(frameState_->prevClickedNode);
+            if (prevNode && prevNode != node)
+            {
+                events::FocusLost evt;
+                prevNode->getEvents().notifyAllChannels<events::FocusLost>(evt);
+            }
+            
+            if (btn == GLFW_MOUSE_BUTTON_LEFT)
+            {
+                events::LMBClick evt;
+                propagateEvent(node, evt);
+            }
+            else if (btn == GLFW_MOUSE_BUTTON_RIGHT)
+            {
+                // events::RMBClick evt;
+                // node->getEvents().notifyAllChannels<events::RMBClick>(evt);
+            }
+        }
+        else if (!frameState_->mouseButtonState[btn])
+        {
+            frameState_->prevClickedNode = frameState_->clickedNode;
+            AbstractNode* prevNode = registry.resolve(frameState_->prevClickedNode);
+            if (prevNode && node != prevNode)
             {
-                frameState_->clickedNodePtr = node;
-                auto prevNode = frameState_->prevClickedNodePtr.lock();
-                auto hoveredNode = frameState_->hoveredNodePtr.lock();
-                if (prevNode && prevNode != node)
-                {
-                    events::FocusLost evt;
-                    prevNode->getEvents().notifyAllChannels<events::FocusLost>(evt);
-                }
-                
                 if (btn == GLFW_MOUSE_BUTTON_LEFT)
                 {
-                    events::LMBClick evt;
-                    node->getEvents().notifyAllChannels<events::LMBClick>(evt);
+                    events::LMBReleaseNotHovered evt;
+                    prevNode->getEvents().notifyAllChannels<events::LMBReleaseNotHovered>(evt);
                 }
                 else if (btn == GLFW_MOUSE_BUTTON_RIGHT)
                 {
-                    // events::RMBClick evt;
-                    // node->getEvents().notifyAllChannels<events::RMBClick>(evt);
+                    // TODO: To be fille if neeeded
                 }
             }
-            else if (!frameState_->mouseButtonState[btn])
-            {
-                frameState_->prevClickedNodePtr = frameState_->clickedNodePtr;
-                if (frameState_->prevClickedNodePtr.lock() && node != frameState_->prevClickedNodePtr.lock())
-                {
-                    if (btn == GLFW_MOUSE_BUTTON_LEFT)
-                    {
-                        events::LMBReleaseNotHovered evt;
-                        frameState_->prevClickedNodePtr.lock()->getEvents()
-                        .notifyAllChannels<events::LMBReleaseNotHovered>(evt);
-                    }
-                    else if (btn == GLFW_MOUSE_BUTTON_RIGHT)
-                    {
-                        // TODO: To be fille if neeeded
-                    }
-                }
 
-                if (btn == GLFW_MOUSE_BUTTON_LEFT)
-                {
-                    if (frameState_->clickedNodePtr.lock() == frameState_->prevClickedNodePtr.lock())
-                    {
-                        events::LMBRelease evt{{mX, mY}};
-                        node->getEvents().notifyAllChannels<events::LMBRelease>(evt);
-                    }
-                }
-                else if (btn == GLFW_MOUSE_BUTTON_RIGHT)
+            if (btn == GLFW_MOUSE_BUTTON_LEFT)
+            {
+                if (frameState_->clickedNode == frameState_->prevClickedNode)
                 {
-                    events::RMBRelease evt{{mX, mY}};
-                    node->getEvents().notifyAllChannels<events::RMBRelease>(evt);
+                    events::LMBRelease evt{{mX, mY}};
+                    propagateEvent(node, evt);
                 }
-
-                frameState_->clickedNodePtr = NO_PTR;
             }
-            break; // event was consumed
+            else if (btn == GLFW_MOUSE_BUTTON_RIGHT)
+            {
+                events::RMBRelease evt{{mX, mY}};
+                propagateEvent(node, evt);
+            }
+
+            frameState_->clickedNode = NO_HANDLE;
         }
     }
 
     /* Means we released the button somewhere outside of the window. */
     if (!foundNode)
     {
-        frameState_->prevClickedNodePtr = frameState_->clickedNodePtr;
-        events::LMBReleaseNotHovered evt;
-        frameState_->prevClickedNodePtr.lock()->getEvents().notifyAllChannels<events::LMBReleaseNotHovered>(evt);
-        frameState_->clickedNodePtr = NO_PTR;
+        frameState_->prevClickedNode = frameState_->clickedNode;
+        if (AbstractNode* prevNode = registry.resolve(frameState_->prevClickedNode))
+        {
+            events::LMBReleaseNotHovered evt;
+            prevNode->getEvents().notifyAllChannels<events::LMBReleaseNotHovered>(evt);
+        }
+        frameState_->clickedNode = NO_HANDLE;
     }
 }
 
@@ -431,77 +663,31 @@ void WindowFrame::resolveOnMouseMoveFromInput(const int32_t x, const int32_t y)
     frameState_->mouseX = x;
     frameState_->mouseY = y;
 
-    for (const auto& node : allFrameChildNodes_)
+    NodeRegistry& registry = NodeRegistry::get();
+    AbstractNode* node = findNodeAt(x, y);
+    if (node && node->getHandle() != frameState_->hoveredNode)
     {
-        /* Skip nodes marked as transparent. Events will be bubbled down to the next valid node. */
-        if (node->isEventTransparent()) { continue; }
-
-        glm::ivec2& nodePos = node->transform_.vPos;
-        glm::ivec2& nodeScale = node->transform_.vScale;
-        if ((x >= nodePos.x && x <= nodePos.x + nodeScale.x) &&
-            (y >= nodePos.y && y <= nodePos.y + nodeScale.y))
+        if (AbstractNode* prevHoveredNode = registry.resolve(frameState_->hoveredNode))
         {
-            if (node != frameState_->hoveredNodePtr.lock())
-            {
-                if (auto prevHoveredNode = frameState_->hoveredNodePtr.lock())
-                {
-                    events::MouseExit evtExit;
-                    prevHoveredNode->getEvents().notifyAllChannels(evtExit);
-                }
-
-                events::MouseEnter evtEnter;
-                node->getEvents().notifyAllChannels(evtEnter);
-
-                frameState_->hoveredNodePtr = node;
-            }
-
-            break; // event was consumed
+            events::MouseExit evtExit;
+            prevHoveredNode->getEvents().notifyAllChannels(evtExit);
         }
-    }
 
-    /* Following will try to find the nearest scrollbar from the hovered node's position.
-       This loop will run at most MAX_HEIGHT_OF_UI_TREE times in the worst case. */
-    frameState_->nearScrollNodePtr = NO_PTR;
-    AbstractNodePtr p = frameState_->hoveredNodePtr.lock();
-    while (p != NO_PTR)
-    {
-        if (p->getType() == AbstractNode::NodeType::SLIDER_KNOB)
-        {
-            frameState_->nearScrollNodePtr = p->getParent();
-        }
-        else if (p->getType() == AbstractNode::NodeType::SLIDER)
-        {
-            frameState_->nearScrollNodePtr = p;
-        }
-        else if (p->getType() == AbstractNode::NodeType::BOX
-            || p->getType() == AbstractNode::NodeType::RECYCLE_LIST
-            || p->getType() == AbstractNode::NodeType::TREEVIEW) // TODO: || NodeType is TreeView/RecycleList
-        {
-            auto box = Utils::as<Box>(p);
-            if (box->isScrollBarActive(utils::Layout::Type::VERTICAL))
-            {
-                frameState_->nearScrollNodePtr = box->getVBar();
-            }
-            // TODO: When CTRL is held pick the horizontal direction instead of the verical one
-            else if (box->isScrollBarActive(utils::Layout::Type::HORIZONTAL))
-            {
-                frameState_->nearScrollNodePtr = box->getHBar();
-            }
-        }
+        events::MouseEnter evtEnter;
+        node->getEvents().notifyAllChannels(evtEnter);
 
-        if (frameState_->nearScrollNodePtr.lock())
-        {
-            break;
-        }
-        p = p->getParent().lock();
+        frameState_->hoveredNode = node->getHandle();
     }
 
     /* Having a selectedNodeId && currently holding down left click means we want to drag only. */
-    if (frameState_->mouseButtonState[GLFW_MOUSE_BUTTON_LEFT] && frameState_->clickedNodePtr.lock() != NO_PTR)
+    if (frameState_->mouseButtonState[GLFW_MOUSE_BUTTON_LEFT])
     {
-        events::LMBDrag evt(x, y);
-        frameState_->clickedNodePtr.lock()->getEvents().notifyAllChannels<events::LMBDrag>(evt);
-        return;
+        if (AbstractNode* clickedNode = registry.resolve(frameState_->clickedNode))
+        {
+            events::LMBDrag evt(x, y);
+            clickedNode->getEvents().notifyAllChannels<events::LMBDrag>(evt);
+            return;
+        }
     }
 }
 
@@ -510,20 +696,22 @@ void WindowFrame::resolveOnMouseWheelFromInput(const int32_t x, const int32_t y)
     /* Note: Yes. GLFW will return to us "double" for this input event and not int32 BUT
         at least on Linux, the return values are -1, 0, 1 and so we can just treat them as ints.
     */
-    if (auto node = frameState_->nearScrollNodePtr.lock())
+    /* Bubbles up from the hovered node, the first slider or box with an active scrollbar on the way takes it. */
+    if (AbstractNode* node = NodeRegistry::get().resolve(frameState_->hoveredNode))
     {
         events::WheelScroll evt{y};
-        node->getEvents().notifyAllChannels(evt);
+        propagateEvent(node, evt);
     }
 }
 
 void WindowFrame::resolveOnMouseEnterExitFromInput(const bool entered)
 {
-    if (auto hoveredNode = frameState_->hoveredNodePtr.lock(); hoveredNode && !entered)
+    AbstractNode* hoveredNode = NodeRegistry::get().resolve(frameState_->hoveredNode);
+    if (hoveredNode && !entered)
     {
         events::MouseExit evtExit;
         hoveredNode->getEvents().notifyAllChannels(evtExit);
-        frameState_->hoveredNodePtr = NO_PTR;
+        frameState_->hoveredNode = NO_HANDLE;
     }
 }
 
@@ -532,10 +720,13 @@ void WindowFrame::resolveOnWindowResizeFromInput(const int32_t newWidth, const i
     frameState_->layoutPassActions = ELayoutPass::EVERYTHING_NODE;
     frameState_->frameSize = {newWidth, newHeight};
 
+    /* Frame size can affect any node (dropdowns, floating boxes), lay everything out again. */
     events::WindowResize evt;
-    for (const auto& node : allFrameChildNodes_)
+    nodeStore_.forEachHighToLow([&evt](const AbstractNodePtr& node)
     {
+        node->isLayoutDirty_ = true;
+        node->hasDirtySubNodes_ = true;
         node->getEvents().notifyAllChannels(evt);
-    }
+    });
 }
 } // namespace msgui
\ No newline at end of file
@@ -7,10 +7,17 @@
 #include "msgui/Window.hpp"
 #include "msgui/Input.hpp"
 #include "msgui/layoutEngine/ITextLayoutEngine.hpp"
+#include "msgui/layoutEngine/utils/ViewableAreaBatch.hpp"
+#include "msgui/layoutEngine/utils/WorkStealingPool.hpp"
 #include "msgui/node/AbstractNode.hpp"
 #include "msgui/node/Box.hpp"
+#include "msgui/node/FrameNodeStore.hpp"
 #include "msgui/node/FrameState.hpp"
+#include "msgui/node/HitTestGrid.hpp"
+#include "msgui/renderer/OffscreenBuffer.hpp"
+#include "msgui/renderer/RectBatchRenderer.hpp"
 #include "msgui/renderer/TextRenderer.hpp"
+#include "msgui/renderer/Types.hpp"
 
 namespace msgui
 {
@@ -30,6 +37,9 @@ static constexpr uint32_t FLOATING_LAYER_START = 300;
 
 static constexpr uint32_t MAX_DEFAULT_CURSORS = 6;
 
+/* Deeper trees just grow the event propagation path once. */
+static constexpr uint32_t PROPAGATION_PATH_RESERVE = 64;
+
 public:
     /**
         Creates a new window frame.
@@ -65,6 +75,28 @@ public:
     */
     bool isPrimary() const;
 
+    /**
+        Get the rendering metrics (draw calls, batched nodes) of the last rendered frame.
+
+        @return Render metrics
+    */
+    const renderer::RenderStats& getRenderStats() const;
+
+    /**
+        Get the underlying OS window.
+
+        @return Window of this frame
+    */
+    const Window& getWindow() const;
+
+    /**
+        Lay out independent subtrees in parallel. Subtrees only depend on their root being placed, so they get
+        spread across a pool of worker threads and joined before text layout. Worth it for big trees only.
+
+        @param threadCount Number of threads to use, including the UI one. 1 or less disables it (default)
+    */
+    void setLayoutThreads(const int32_t threadCount);
+
 private: // friend
     friend Application;
 
@@ -78,7 +110,19 @@ private: // friend
 private:
     void renderLayout();
     void updateLayout();
+    bool layoutNodes();
+    bool layoutNodesParallel();
+    void layoutSubtreeTask(const AbstractNodePtr& node, const int32_t workerIdx);
+    bool layoutSubtree(const AbstractNodePtr& node);
+    bool isSubtreeClean(const AbstractNodePtr& node) const;
+    bool layoutNode(const AbstractNodePtr& node, ILayoutEngine::PendingOverflows* pendingOverflows);
+    void computeViewableAreas();
     void resolveNodeRelations();
+    void attachSubtree(const AbstractNodePtr& parent, const AbstractNodePtr& node);
+    AbstractNode* findNodeAt(const int32_t x, const int32_t y);
+    void buildPropagationPath(AbstractNode* target);
+    template<typename T>
+    void propagateEvent(AbstractNode* target, T& evt);
 
     void resolveOnMouseButtonFromInput(const int32_t btn, const int32_t action);
     void resolveOnMouseMoveFromInput(const int32_t x, const int32_t y);
@@ -86,6 +130,15 @@ private:
     void resolveOnMouseEnterExitFromInput(const bool entered);
     void resolveOnWindowResizeFromInput(const int32_t newWidth, const int32_t newHeight);
 
+private:
+    /* What each worker collected during a parallel layout pass, to be handled on the main thread. */
+    struct LayoutWorkerOutput
+    {
+        ILayoutEngine::PendingOverflows pendingOverflows;
+        std::vector<AbstractNodePtr> mainThreadNodes;
+        bool hasError{false};
+    };
+
 private:
     Logger log_;
     Window window_;
@@ -93,9 +146,18 @@ private:
     FrameStatePtr frameState_{nullptr};
     bool shouldWindowClose_{false};
     ILayoutEnginePtr layoutEngine_{nullptr};
+    renderer::OffscreenBuffer offscreenBuffer_;
+    renderer::RectBatchRenderer rectRenderer_;
     renderer::TextRenderer textRenderer_;
+    renderer::RenderStats renderStats_;
     ITextLayoutEnginePtr textLayoutEngine_{nullptr};
-    std::vector<AbstractNodePtr> allFrameChildNodes_;
+    FrameNodeStore nodeStore_;
+    HitTestGrid hitTestGrid_;
+    bool isHitTestGridDirty_{true};
+    std::vector<NodeHandle> propagationPath_;
+    utils::ViewableAreaBatch viewableAreaBatch_;
+    std::unique_ptr<utils::WorkStealingPool> layoutPool_{nullptr};
+    std::vector<LayoutWorkerOutput> layoutWorkerOutputs_;
     BoxPtr frameBox_{nullptr};
     bool isPrimary_{false};
 
@@ -18,6 +18,7 @@ public:
     BoxDividerSep(const std::string& name, const BoxPtr& firstBox, const BoxPtr& secondBox);
 
     void setShaderAttributes() override;
+    bool setInstanceAttributes(renderer::RectInstanceData& data) override;
 
     BoxDividerSep& setColor(const glm::vec4 color);
     BoxDividerSep& setBorderColor(const glm::vec4 color);
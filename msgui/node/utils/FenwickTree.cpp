@@ -0,0 +1,72 @@
+#include "FenwickTree.hpp"
+
+#include <bit>
+
+namespace msgui::node::utils
+{
+void FenwickTree::assign(const std::vector<int32_t>& values)
+{
+    const int32_t size = values.size();
+    tree_.assign(size + 1, 0);
+    total_ = 0;
+
+    /* Linear build, each node hands its sum over to the next node covering it. */
+    for (int32_t i = 1; i <= size; i++)
+    {
+        tree_[i] += values[i - 1];
+        total_ += values[i - 1];
+        const int32_t parent = i + (i & -i);
+        if (parent <= size) { tree_[parent] += tree_[i]; }
+    }
+}
+
+void FenwickTree::pushBack(const int32_t value)
+{
+    /* New node covers itself plus the elements right before it that its low bit spans. */
+    const int32_t i = tree_.size();
+    const int32_t span = i & -i;
+    tree_.push_back(value + prefixSum(i - 1) - prefixSum(i - span));
+    total_ += value;
+}
+
+void FenwickTree::add(const int32_t idx, const int32_t delta)
+{
+    const int32_t size = getSize();
+    for (int32_t i = idx + 1; i <= size; i += i & -i)
+    {
+        tree_[i] += delta;
+    }
+    total_ += delta;
+}
+
+int32_t FenwickTree::prefixSum(int32_t idx) const
+{
+    int32_t sum{0};
+    for (; idx > 0; idx -= idx & -idx)
+    {
+        sum += tree_[idx];
+    }
+    return sum;
+}
+
+int32_t FenwickTree::find(int32_t& target) const
+{
+    /* Descend from the highest power of two, skipping every block whose sum still fits below the target. */
+    const int32_t size = getSize();
+    int32_t pos{0};
+    for (int32_t step = std::bit_floor((uint32_t)size); step > 0; step >>= 1)
+    {
+        const int32_t next = pos + step;
+        if (next <= size && tree_[next] <= target)
+        {
+            pos = next;
+            target -= tree_[next];
+        }
+    }
+    return pos;
+}
+
+int32_t FenwickTree::getTotal() const { return total_; }
+
+int32_t FenwickTree::getSize() const { return tree_.size() - 1; }
+} // namespace msgui::node::utils
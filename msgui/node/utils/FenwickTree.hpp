@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace msgui::node::utils
+{
+/* Binary indexed tree over a sequence of counts. Changing a count, summing a prefix and finding which element a
+   running total falls into are all logarithmic, which is what turning a flat row index into a tree item needs. */
+class FenwickTree
+{
+public:
+    /**
+        Replace the whole sequence.
+
+        @param values New counts
+    */
+    void assign(const std::vector<int32_t>& values);
+
+    /**
+        Append a count at the end of the sequence.
+
+        @param value Count to append
+    */
+    void pushBack(const int32_t value);
+
+    /**
+        Change the count at an index.
+
+        @param idx Index of the element
+        @param delta Amount to add to the count
+    */
+    void add(const int32_t idx, const int32_t delta);
+
+    /**
+        Sum the counts before an index.
+
+        @param idx Number of leading elements to sum
+
+        @return Sum of counts in [0, idx)
+    */
+    int32_t prefixSum(int32_t idx) const;
+
+    /**
+        Find the element a running total falls into, meaning prefixSum(idx) <= target < prefixSum(idx + 1).
+
+        @param target Running total to look for. Left with the offset inside the found element
+
+        @return Index of the element or getSize() if target is past the total
+    */
+    int32_t find(int32_t& target) const;
+
+    /**
+        Get the sum of all counts.
+
+        @return Total count
+    */
+    int32_t getTotal() const;
+
+    /**
+        Get the number of elements.
+
+        @return Element count
+    */
+    int32_t getSize() const;
+
+private:
+    /* One based internally, tree_[i] holds the sum of the (i & -i) counts ending at element i - 1. */
+    std::vector<int32_t> tree_{0};
+    int32_t total_{0};
+};
+} // namespace msgui::node::utils
@@ -1,7 +1,10 @@
 #pragma once
 
-#include <string>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <span>
+#include <string>
 
 #include <glm/glm.hpp>
 
@@ -15,4 +18,9 @@ struct ListItem
 
 using ListItemPtr = std::shared_ptr<ListItem>;
 using ListItemWPtr = std::weak_ptr<ListItem>;
+
+/* Data source callbacks for lists that don't own their items. The passed items are reused between calls, so
+   assigning into them keeps their string storage around instead of allocating again. */
+using ListItemFetchFunc = std::function<void(const int32_t idx, ListItem& item)>;
+using ListItemBatchFetchFunc = std::function<void(const int32_t firstIdx, std::span<ListItem> items)>;
 } // namespace msgui::node::utils
@@ -3,6 +3,7 @@
 #include "msgui/events/LMBRelease.hpp"
 #include "msgui/loaders/MeshLoader.hpp"
 #include "msgui/loaders/ShaderLoader.hpp"
+#include "msgui/renderer/Uniforms.hpp"
 #include "msgui/node/AbstractNode.hpp"
 #include "msgui/layoutEngine/utils/LayoutData.hpp"
 #include "msgui/node/Slider.hpp"
@@ -32,12 +33,18 @@ void SliderKnob::setShaderAttributes()
 {
     transform_.computeModelMatrix();
     auto shader = getShader();
-    shader->setMat4f("uModelMat", transform_.modelMatrix);
-    shader->setVec4f("uColor", color_);
-    shader->setVec4f("uBorderColor", borderColor_);
-    shader->setVec4f("uBorderSize", getLayout().border);
-    shader->setVec4f("uBorderRadii", getLayout().borderRadius);
-    shader->setVec2f("uResolution", glm::vec2{transform_.scale.x, transform_.scale.y});
+    const renderer::Uniforms& uniforms = renderer::Uniforms::get();
+    shader->setMat4f(uniforms.modelMat, transform_.modelMatrix);
+    shader->setVec4f(uniforms.color, color_);
+    shader->setVec4f(uniforms.borderColor, borderColor_);
+    shader->setVec4f(uniforms.borderSize, getLayout().border);
+    shader->setVec4f(uniforms.borderRadii, getLayout().borderRadius);
+    shader->setVec2f(uniforms.resolution, glm::vec2{transform_.scale.x, transform_.scale.y});
+}
+
+bool SliderKnob::setInstanceAttributes(renderer::RectInstanceData& data)
+{
+    return fillRectInstance(data, color_, borderColor_);
 }
 
 void SliderKnob::onMouseClick(const events::LMBClick& evt)
@@ -82,12 +89,14 @@ void SliderKnob::onMouseDrag(const events::LMBDrag& evt)
 SliderKnob& SliderKnob::setColor(const glm::vec4& color)
 {
     color_ = color;
+    MAKE_NODE_DAMAGED;
     return *this;
 }
 
 SliderKnob& SliderKnob::setBorderColor(const glm::vec4& color)
 {
     borderColor_ = color;
+    MAKE_NODE_DAMAGED;
     return *this;
 }
 
@@ -24,6 +24,7 @@ public:
 
 private:
     void setShaderAttributes() override;
+    bool setInstanceAttributes(renderer::RectInstanceData& data) override;
     void onMouseClick(const events::LMBClick& evt);
     void onMouseRelease(const events::LMBRelease& evt);
     void onMouseDrag(const events::LMBDrag& evt);
@@ -1,9 +1,13 @@
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 #include <glm/glm.hpp>
 
+#include "msgui/node/utils/FenwickTree.hpp"
+
 namespace msgui
 {
 struct TreeItem;
@@ -16,34 +20,86 @@ struct TreeItem : std::enable_shared_from_this<TreeItem>
     void addItem(TreeItemPtr& item)
     {
         item->depth = depth + 1;
+        item->indexInParent = subItems.size();
         subItems.emplace_back(item);
+        subItemCounts.pushBack(item->visibleCount);
         item->parentItem = shared_from_this();
+        updateVisibleCount();
+    }
+
+    void removeItems()
+    {
+        subItems.clear();
+        subItemCounts.assign({});
+        updateVisibleCount();
     }
 
     void toggle() { isOpen ? close() : open(); }
 
     void open()
     {
+        if (isOpen) { return; }
+
         isOpen = true;
+        updateVisibleCount();
     }
-    
+
     void close()
     {
         if (!isOpen) { return; }
 
         isOpen = false;
-        /* Also recursively close any child nodes. */
+        /* Also recursively close any child nodes. Their counts stop propagating here since we're closed now. */
         for (auto& item : subItems) { item->close(); }
+        updateVisibleCount();
+    }
+
+    /**
+        Recompute how many rows this item takes and pass the difference to the parents, up to the first closed one.
+        Only needed when isOpen or subItems get changed by hand, the functions above keep counts up to date.
+    */
+    void updateVisibleCount()
+    {
+        const int32_t newCount = 1 + (isOpen ? subItemCounts.getTotal() : 0);
+        const int32_t delta = newCount - visibleCount;
+        if (delta == 0) { return; }
+
+        visibleCount = newCount;
+        TreeItem* child = this;
+        TreeItemPtr parent = parentItem.lock();
+        while (parent)
+        {
+            parent->subItemCounts.add(child->indexInParent, delta);
+            if (!parent->isOpen) { break; }
+
+            parent->visibleCount += delta;
+            child = parent.get();
+            parent = parent->parentItem.lock();
+        }
     }
 
     /* User set payload */
     glm::vec4 color;
     std::string text;
 
+    /* User set. Sub items aren't there yet, the TreeView fetches them the first time the item gets opened. */
+    bool hasLazyChildren{false};
+
     /* Internal management */
     int32_t depth{0};
     bool isOpen{false};
+    bool isPlaceholder{false};
     TreeItemWPtr parentItem;
     TreeItemPtrVec subItems;
+
+    /* Rows taken when the parent is open: the item itself plus its visible descendants. Sub items' counts are kept
+       in a fenwick tree so a row index can be turned into an item without walking over the rows before it. */
+    int32_t visibleCount{1};
+    int32_t indexInParent{0};
+    node::utils::FenwickTree subItemCounts;
 };
-} // namespace msgui
\ No newline at end of file
+
+/* Fetches the sub items of an item marked with hasLazyChildren. When called from a worker thread, the passed item is
+   a detached copy holding the color, text and depth of the item, not the item in the tree. */
+using TreeItemChildrenFetchFunc = std::function<TreeItemPtrVec(const TreeItemPtr& item)>;
+} // namespace msgui
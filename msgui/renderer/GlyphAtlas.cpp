@@ -0,0 +1,237 @@
+#include "GlyphAtlas.hpp"
+
+#include <algorithm>
+
+namespace msgui::renderer
+{
+GlyphAtlas& GlyphAtlas::get()
+{
+    static GlyphAtlas instance;
+    return instance;
+}
+
+GlyphAtlas::GlyphAtlas()
+{
+    /* Reserve the empty slot. */
+    rects_.emplace_back(0);
+}
+
+GlyphAtlas::~GlyphAtlas()
+{
+    glDeleteTextures(1, &texId_);
+    glDeleteTextures(1, &rectsTexId_);
+    glDeleteBuffers(1, &rectsTboId_);
+}
+
+uint32_t GlyphAtlas::addGlyph(const glm::ivec2& size, const uint8_t* pixels, glm::ivec4& outRect)
+{
+    outRect = glm::ivec4{0};
+    if (size.x <= 0 || size.y <= 0) { return EMPTY_SLOT; }
+
+    if (freeSlots_.empty() && (int32_t)rects_.size() >= MAX_SLOTS)
+    {
+        log_.errorLn("No more glyph slots available!");
+        return EMPTY_SLOT;
+    }
+
+    /* Atlas is created lazily as loading needs to happen on the GL thread anyway. */
+    if (!texId_) { createTextures(); }
+
+    glm::ivec2 pos;
+    while (!findSpot(size, pos))
+    {
+        if (!grow())
+        {
+            log_.errorLn("Atlas is full, glyph of size %dx%d will not be shown!", size.x, size.y);
+            return EMPTY_SLOT;
+        }
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glBindTexture(GL_TEXTURE_2D, texId_);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, pos.x, pos.y, size.x, size.y, GL_RED, GL_UNSIGNED_BYTE, pixels);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    outRect = glm::ivec4{pos.x, pos.y, size.x, size.y};
+    usedArea_ += size.x * size.y;
+
+    uint32_t slot = rects_.size();
+    if (!freeSlots_.empty())
+    {
+        slot = freeSlots_.back();
+        freeSlots_.pop_back();
+        rects_[slot] = outRect;
+    }
+    else
+    {
+        rects_.emplace_back(outRect);
+    }
+    uploadRect(slot);
+
+    return slot;
+}
+
+void GlyphAtlas::removeGlyph(const uint32_t slot)
+{
+    if (slot == EMPTY_SLOT || slot >= rects_.size() || rects_[slot].z <= 0) { return; }
+
+    /* Texels are cleared before being reused. Glyphs only upload their own size, the padding around them relies on
+       the area being zero so that linear filtering at the edges doesn't blend in what was there before. */
+    const glm::ivec4 rect = rects_[slot];
+    const glm::ivec4 paddedRect{rect.x, rect.y, rect.z + PADDING, rect.w + PADDING};
+    glClearTexSubImage(texId_, 0, paddedRect.x, paddedRect.y, 0, paddedRect.z, paddedRect.w, 1, GL_RED,
+        GL_UNSIGNED_BYTE, nullptr);
+    freeRects_.emplace_back(paddedRect);
+    usedArea_ -= rect.z * rect.w;
+
+    rects_[slot] = glm::ivec4{0};
+    uploadRect(slot);
+    freeSlots_.push_back(slot);
+}
+
+float GlyphAtlas::getOccupancy() const
+{
+    return usedArea_ * 100.0f / (size_.x * size_.y);
+}
+
+void GlyphAtlas::reportOccupancy() const
+{
+    log_.infoLn("Atlas %dx%d holds %d glyphs, %.2f%% occupied", size_.x, size_.y,
+        (int32_t)(rects_.size() - freeSlots_.size()) - 1, getOccupancy());
+}
+
+uint32_t GlyphAtlas::getTexId() const { return texId_; }
+
+uint32_t GlyphAtlas::getRectsTexId() const { return rectsTexId_; }
+
+glm::ivec2 GlyphAtlas::getSize() const { return size_; }
+
+void GlyphAtlas::createTextures()
+{
+    glGenTextures(1, &texId_);
+    glBindTexture(GL_TEXTURE_2D, texId_);
+    /* Unused texels act as the padding of the glyphs, so they need to be zero rather than undefined. */
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, size_.x, size_.y, 0, GL_RED, GL_UNSIGNED_BYTE, nullptr);
+    glClearTexImage(texId_, 0, GL_RED, GL_UNSIGNED_BYTE, nullptr);
+
+    /* Wrapping, mag & min settings. */
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    /* Texture buffer views the rects as a list of ivec4s, one per slot. */
+    glGenBuffers(1, &rectsTboId_);
+    glGenTextures(1, &rectsTexId_);
+    glBindTexture(GL_TEXTURE_BUFFER, rectsTexId_);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32I, rectsTboId_);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+}
+
+bool GlyphAtlas::findSpot(const glm::ivec2& size, glm::ivec2& outPos)
+{
+    const glm::ivec2 paddedSize = size + PADDING;
+
+    /* Space left behind by removed glyphs comes first. */
+    if (findFreedSpot(paddedSize, outPos)) { return true; }
+
+    /* Pick the shortest shelf the glyph fits in to not waste vertical space. */
+    Shelf* bestShelf = nullptr;
+    for (auto& shelf : shelves_)
+    {
+        if (shelf.height < paddedSize.y || shelf.nextX + paddedSize.x > size_.x) { continue; }
+        if (!bestShelf || shelf.height < bestShelf->height) { bestShelf = &shelf; }
+    }
+
+    /* Otherwise open a new shelf under the last one. */
+    if (!bestShelf)
+    {
+        const int32_t nextY = shelves_.empty() ? 0 : shelves_.back().y + shelves_.back().height;
+        if (nextY + paddedSize.y > size_.y || paddedSize.x > size_.x) { return false; }
+
+        bestShelf = &shelves_.emplace_back(Shelf{.y = nextY, .height = paddedSize.y, .nextX = 0});
+    }
+
+    outPos = glm::ivec2{bestShelf->nextX, bestShelf->y};
+    bestShelf->nextX += paddedSize.x;
+    return true;
+}
+
+bool GlyphAtlas::findFreedSpot(const glm::ivec2& paddedSize, glm::ivec2& outPos)
+{
+    /* Best fit by area, but don't put short glyphs in much taller holes as the rest of the height is lost. */
+    int32_t bestIdx = -1;
+    for (int32_t i = 0; i < (int32_t)freeRects_.size(); i++)
+    {
+        const glm::ivec4& rect = freeRects_[i];
+        if (rect.z < paddedSize.x || rect.w < paddedSize.y || rect.w > paddedSize.y * 2) { continue; }
+        if (bestIdx == -1 || rect.z * rect.w < freeRects_[bestIdx].z * freeRects_[bestIdx].w) { bestIdx = i; }
+    }
+
+    if (bestIdx == -1) { return false; }
+
+    glm::ivec4& rect = freeRects_[bestIdx];
+    outPos = glm::ivec2{rect.x, rect.y};
+
+    /* Whatever is left to the right can still be used by other glyphs. */
+    rect.x += paddedSize.x;
+    rect.z -= paddedSize.x;
+    if (rect.z <= 0)
+    {
+        freeRects_[bestIdx] = freeRects_.back();
+        freeRects_.pop_back();
+    }
+    return true;
+}
+
+bool GlyphAtlas::grow()
+{
+    if (size_.x >= MAX_SIZE) { return false; }
+
+    /* Existing glyphs keep their texel positions, so only the texture itself needs to be copied over. Shelves just
+       get more room to the right and new shelves fit underneath. */
+    const glm::ivec2 newSize = glm::min(size_ * 2, glm::ivec2{MAX_SIZE});
+
+    uint32_t newTexId = 0;
+    glGenTextures(1, &newTexId);
+    glBindTexture(GL_TEXTURE_2D, newTexId);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, newSize.x, newSize.y, 0, GL_RED, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    /* Storage starts out undefined, what the old texture doesn't cover must read as empty padding. */
+    glClearTexImage(newTexId, 0, GL_RED, GL_UNSIGNED_BYTE, nullptr);
+    glCopyImageSubData(texId_, GL_TEXTURE_2D, 0, 0, 0, 0, newTexId, GL_TEXTURE_2D, 0, 0, 0, 0, size_.x, size_.y, 1);
+    glDeleteTextures(1, &texId_);
+
+    texId_ = newTexId;
+    size_ = newSize;
+
+    log_.infoLn("Grown to %dx%d", size_.x, size_.y);
+    return true;
+}
+
+void GlyphAtlas::uploadRect(const uint32_t slot)
+{
+    glBindBuffer(GL_TEXTURE_BUFFER, rectsTboId_);
+
+    /* Reallocate with room to spare, otherwise only the new rect needs to go in. */
+    const int64_t requiredSize = sizeof(glm::ivec4) * rects_.size();
+    if (requiredSize > rectsCapacity_)
+    {
+        rectsCapacity_ = std::max(requiredSize * 2, (int64_t)sizeof(glm::ivec4) * MIN_RECTS_CAPACITY);
+        glBufferData(GL_TEXTURE_BUFFER, rectsCapacity_, nullptr, GL_DYNAMIC_DRAW);
+        glBufferSubData(GL_TEXTURE_BUFFER, 0, requiredSize, rects_.data());
+    }
+    else
+    {
+        glBufferSubData(GL_TEXTURE_BUFFER, sizeof(glm::ivec4) * slot, sizeof(glm::ivec4), &rects_[slot]);
+    }
+
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+} // namespace msgui::renderer
\ No newline at end of file
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "msgui/Logger.hpp"
+
+namespace msgui::renderer
+{
+/* Single texture holding the glyph bitmaps of all loaded fonts and sizes, packed in shelves. Each glyph gets a slot
+   whose texel rect is also kept in a texture buffer so the text shader can look it up by slot. */
+class GlyphAtlas
+{
+public:
+    static GlyphAtlas& get();
+
+    /**
+        Pack a glyph bitmap into the atlas. Atlas grows if there's no space left.
+
+        @param size Size of the bitmap in pixels
+        @param pixels Single channel bitmap rows, tightly packed
+        @param outRect Texel rect (x, y, w, h) the glyph got placed at
+
+        @return Slot of the glyph or EMPTY_SLOT if it couldn't be packed (or it has no pixels)
+    */
+    uint32_t addGlyph(const glm::ivec2& size, const uint8_t* pixels, glm::ivec4& outRect);
+
+    /**
+        Release the slot & area of a glyph so they can be reused by future glyphs.
+
+        @param slot Slot of the glyph to remove
+    */
+    void removeGlyph(const uint32_t slot);
+
+    /**
+        Get percentage of the atlas area currently used by glyphs.
+
+        @return Occupancy in range [0, 100]
+    */
+    float getOccupancy() const;
+
+    /**
+        Log size, glyph count and occupancy of the atlas.
+    */
+    void reportOccupancy() const;
+
+    /* Trivial getters */
+    uint32_t getTexId() const;
+    uint32_t getRectsTexId() const;
+    glm::ivec2 getSize() const;
+
+    /* Slot used for glyphs without a bitmap (spaces) or glyphs that didn't fit. */
+    static constexpr uint32_t EMPTY_SLOT{0};
+
+private:
+    /* Horizontal strip of the atlas, holds glyphs no taller than itself. */
+    struct Shelf
+    {
+        int32_t y{0};
+        int32_t height{0};
+        int32_t nextX{0};
+    };
+
+    GlyphAtlas();
+    ~GlyphAtlas();
+
+    /* Cannot be copied or moved */
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas(GlyphAtlas&&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(GlyphAtlas&&) = delete;
+
+    void createTextures();
+    bool findSpot(const glm::ivec2& size, glm::ivec2& outPos);
+    bool findFreedSpot(const glm::ivec2& paddedSize, glm::ivec2& outPos);
+    bool grow();
+    void uploadRect(const uint32_t slot);
+
+private:
+    Logger log_{"GlyphAtlas"};
+    uint32_t texId_{0};
+    uint32_t rectsTboId_{0};
+    uint32_t rectsTexId_{0};
+    int64_t rectsCapacity_{0};
+    glm::ivec2 size_{INITIAL_SIZE};
+    int64_t usedArea_{0};
+    std::vector<Shelf> shelves_;
+    std::vector<glm::ivec4> rects_;
+    std::vector<uint32_t> freeSlots_;
+    std::vector<glm::ivec4> freeRects_;
+
+    static constexpr int32_t INITIAL_SIZE{512};
+    static constexpr int32_t MAX_SIZE{4096};
+    static constexpr int32_t MAX_SLOTS{1 << 16};
+    static constexpr int32_t PADDING{1};
+    static constexpr int32_t MIN_RECTS_CAPACITY{512};
+};
+} // namespace msgui::renderer
\ No newline at end of file
@@ -2,12 +2,12 @@
 
 #include <GL/glew.h>
 
-#include "msgui/Window.hpp"
+#include "msgui/renderer/Uniforms.hpp"
 
 namespace msgui::renderer
 {
 /* Class responsible for simple rendering of any node */
-void NodeRenderer::render(AbstractNodePtr node, const glm::mat4& projMat, int32_t frameSizeY)
+void NodeRenderer::render(AbstractNodePtr node, const glm::mat4& projMat)
 {
     auto& t = node->getTransform();
 
@@ -15,18 +15,12 @@ void NodeRenderer::render(AbstractNodePtr node, const glm::mat4& projMat, int32_
     if (t.vScale.x <= 0 || t.vScale.y <= 0) { return; }
     node->getMesh()->bind();
     node->setShaderAttributes();
-    node->getShader()->setMat4f("uProjMat", projMat);
+    const Uniforms& uniforms = Uniforms::get();
+    node->getShader()->setMat4f(uniforms.projMat, projMat);
+
+    /* Clipping to the viewable area is done inside the shader so no scissor state change is needed. */
+    node->getShader()->setVec4f(uniforms.clipRect, glm::vec4{t.vPos.x, t.vPos.y, t.vScale.x, t.vScale.y});
 
-    // printf("%d\n", frameSizeY);
-    // printf("vPos %d %d vScale %d %d\n", t.vPos.x, t.vPos.y, t.vScale.x, t.vScale.y);
-    // Window::setScissorTest(false);
-    glScissor(
-        t.vPos.x,
-        // Height can be computed based on the projMat alone
-        frameSizeY - t.vPos.y - t.vScale.y,
-        // std::floor((-2.0f / projMat[1][1])) - t.vPos.y - t.vScale.y,
-        t.vScale.x,
-        t.vScale.y);
     glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, (void*)0);
 }
 } // namespace msguirenderer
\ No newline at end of file
@@ -13,8 +13,7 @@ public:
 
         @param node Node to be rendered
         @param projMat Orthographic projection matrix to be used
-        @param frameSizeY Vetical size of the frame (window)
     */
-    static void render(AbstractNodePtr node, const glm::mat4& projMat, int32_t frameSizeY);
+    static void render(AbstractNodePtr node, const glm::mat4& projMat);
 };
 } // namespace msgui::renderer
\ No newline at end of file
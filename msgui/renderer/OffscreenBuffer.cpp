@@ -0,0 +1,63 @@
+#include "OffscreenBuffer.hpp"
+
+namespace msgui::renderer
+{
+OffscreenBuffer::~OffscreenBuffer()
+{
+    destroy();
+}
+
+bool OffscreenBuffer::resize(const glm::ivec2& size)
+{
+    if (fboId_ && size_ == size) { return false; }
+
+    destroy();
+    size_ = size;
+
+    glGenFramebuffers(1, &fboId_);
+    glBindFramebuffer(GL_FRAMEBUFFER, fboId_);
+
+    glGenRenderbuffers(1, &colorRboId_);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorRboId_);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, size_.x, size_.y);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorRboId_);
+
+    glGenRenderbuffers(1, &depthRboId_);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthRboId_);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, size_.x, size_.y);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthRboId_);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        log_.errorLn("Framebuffer of size %dx%d is incomplete!", size_.x, size_.y);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    return true;
+}
+
+void OffscreenBuffer::bind() const
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, fboId_);
+}
+
+void OffscreenBuffer::blitToScreen() const
+{
+    /* Blit ignores depth & blending but not the scissor, so the whole area needs to be unmasked. */
+    glScissor(0, 0, size_.x, size_.y);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fboId_);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0, 0, size_.x, size_.y, 0, 0, size_.x, size_.y, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void OffscreenBuffer::destroy()
+{
+    if (!fboId_) { return; }
+
+    glDeleteRenderbuffers(1, &colorRboId_);
+    glDeleteRenderbuffers(1, &depthRboId_);
+    glDeleteFramebuffers(1, &fboId_);
+    fboId_ = colorRboId_ = depthRboId_ = 0;
+}
+} // namespace msgui::renderer
\ No newline at end of file
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "msgui/Logger.hpp"
+
+namespace msgui::renderer
+{
+/* Class holding a persistent color + depth framebuffer. Contents survive between frames so only the damaged parts
+   of the frame need to be redrawn before the whole buffer gets blitted to the window. */
+class OffscreenBuffer
+{
+public:
+    OffscreenBuffer() = default;
+    ~OffscreenBuffer();
+
+    /**
+        Make sure the buffer storage matches the given size. Storage is recreated if needed.
+
+        @param size Wanted size of the buffer
+
+        @return True if the storage got recreated and the previous contents are lost
+    */
+    bool resize(const glm::ivec2& size);
+
+    /**
+        Bind the buffer as draw target.
+    */
+    void bind() const;
+
+    /**
+        Copy buffer contents to the default framebuffer (window's back buffer).
+    */
+    void blitToScreen() const;
+
+private:
+    /* Cannot be copied or moved */
+    OffscreenBuffer(const OffscreenBuffer&) = delete;
+    OffscreenBuffer(OffscreenBuffer&&) = delete;
+    OffscreenBuffer& operator=(const OffscreenBuffer&) = delete;
+    OffscreenBuffer& operator=(OffscreenBuffer&&) = delete;
+
+    void destroy();
+
+private:
+    Logger log_{"OffscreenBuffer"};
+    uint32_t fboId_{0};
+    uint32_t colorRboId_{0};
+    uint32_t depthRboId_{0};
+    glm::ivec2 size_{0};
+};
+} // namespace msgui::renderer
\ No newline at end of file
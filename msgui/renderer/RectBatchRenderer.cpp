@@ -0,0 +1,179 @@
+#include "RectBatchRenderer.hpp"
+
+#include <cstddef>
+
+#include "msgui/loaders/MeshLoader.hpp"
+#include "msgui/loaders/ShaderLoader.hpp"
+#include "msgui/renderer/NodeRenderer.hpp"
+#include "msgui/renderer/Uniforms.hpp"
+
+namespace msgui::renderer
+{
+RectBatchRenderer::RectBatchRenderer()
+{
+    /* Quad needs its own vao as we attach the instanced attributes to it. */
+    mesh_ = loaders::MeshLoader::loadQuad("//iRectBatchQuadMesh");
+    shader_ = loaders::ShaderLoader::loadShader("assets/shader/sdfRectInstanced.glsl");
+
+    setupInstanceLayers();
+}
+
+RectBatchRenderer::~RectBatchRenderer()
+{
+    glDeleteBuffers(1, &instanceVboId_);
+}
+
+void RectBatchRenderer::render(const FrameNodeStore& nodes, const glm::mat4& projMat,
+    const DamageArea& damageArea)
+{
+    stats_ = RenderStats{};
+
+    /* Layout didn't change since last time, only visual properties of some nodes could have. */
+    isInvalid_ ? compileCommands(nodes) : patchInstances(damageArea.nodeIds);
+
+    /* No culling against the damaged area is needed here. The scissor already limits the fill and replaying
+       the few retained batches is cheaper than splitting them. */
+    replayCommands(projMat);
+}
+
+void RectBatchRenderer::invalidate()
+{
+    isInvalid_ = true;
+}
+
+const RenderStats& RectBatchRenderer::getStats() const { return stats_; }
+
+void RectBatchRenderer::setupInstanceLayers()
+{
+    mesh_->bind();
+
+    glGenBuffers(1, &instanceVboId_);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVboId_);
+
+    uint32_t idx = INSTANCE_LAYER_START;
+    addInstanceLayer(idx++, 3, offsetof(RectInstanceData, pos));
+    addInstanceLayer(idx++, 2, offsetof(RectInstanceData, scale));
+    addInstanceLayer(idx++, 4, offsetof(RectInstanceData, color));
+    addInstanceLayer(idx++, 4, offsetof(RectInstanceData, borderColor));
+    addInstanceLayer(idx++, 4, offsetof(RectInstanceData, borderSize));
+    addInstanceLayer(idx++, 4, offsetof(RectInstanceData, borderRadii));
+    addInstanceLayer(idx++, 4, offsetof(RectInstanceData, clipRect));
+}
+
+void RectBatchRenderer::addInstanceLayer(const uint32_t index, const uint32_t count, const uint64_t offset)
+{
+    glVertexAttribPointer(index, count, GL_FLOAT, false, sizeof(RectInstanceData), (void*)offset);
+    glEnableVertexAttribArray(index);
+
+    /* Advance once per instance instead of once per vertex. */
+    glVertexAttribDivisor(index, 1);
+}
+
+void RectBatchRenderer::compileCommands(const FrameNodeStore& nodes)
+{
+    commands_.clear();
+    instanceBuffer_.clear();
+    nodeIdToInstance_.clear();
+
+    nodes.forEachLowToHigh([this](const AbstractNodePtr& node)
+    {
+        const auto& t = node->getTransform();
+
+        /* Skip rendering objects that have no viewable area. */
+        if (t.vScale.x <= 0 || t.vScale.y <= 0) { return; }
+
+        RectInstanceData data;
+        if (!node->setInstanceAttributes(data))
+        {
+            /* Node can't be batched. Close the current batch so that draw order is kept. */
+            commands_.emplace_back(DrawCommand{.node = node});
+            return;
+        }
+
+        /* Open a new batch if the previous command was a standalone node or nothing at all. */
+        if (commands_.empty() || commands_.back().node)
+        {
+            commands_.emplace_back(DrawCommand{.instanceStart = (int32_t)instanceBuffer_.size()});
+        }
+        commands_.back().instanceCount++;
+
+        fillInstanceGeometry(data, node.get());
+        nodeIdToInstance_[node->getId()] = InstanceRef{node.get(), (int32_t)instanceBuffer_.size()};
+        instanceBuffer_.emplace_back(data);
+    });
+
+    /* Upload everything once, later frames only patch what changed. */
+    const int64_t requiredSize = sizeof(RectInstanceData) * instanceBuffer_.size();
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVboId_);
+    if (requiredSize > instanceVboCapacity_)
+    {
+        instanceVboCapacity_ = requiredSize;
+        glBufferData(GL_ARRAY_BUFFER, instanceVboCapacity_, instanceBuffer_.data(), GL_DYNAMIC_DRAW);
+    }
+    else
+    {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, requiredSize, instanceBuffer_.data());
+    }
+
+    isInvalid_ = false;
+}
+
+void RectBatchRenderer::patchInstances(const std::vector<uint32_t>& nodeIds)
+{
+    if (nodeIds.empty()) { return; }
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVboId_);
+    for (const uint32_t id : nodeIds)
+    {
+        /* Damaged node might not be batched or visible at all. */
+        const auto it = nodeIdToInstance_.find(id);
+        if (it == nodeIdToInstance_.end()) { continue; }
+
+        const auto& [node, index] = it->second;
+        RectInstanceData& data = instanceBuffer_[index];
+        node->setInstanceAttributes(data);
+        fillInstanceGeometry(data, node);
+
+        glBufferSubData(GL_ARRAY_BUFFER, sizeof(RectInstanceData) * index, sizeof(RectInstanceData), &data);
+
+        /* Metrics */
+        stats_.patchedNodes++;
+    }
+}
+
+void RectBatchRenderer::replayCommands(const glm::mat4& projMat)
+{
+    /* Uniform values stick with the program so this survives standalone nodes binding other shaders. */
+    shader_->setMat4f(Uniforms::get().projMat, projMat);
+
+    for (const auto& command : commands_)
+    {
+        if (command.node)
+        {
+            NodeRenderer::render(command.node, projMat);
+
+            /* Metrics */
+            stats_.drawCalls++;
+            stats_.unbatchedNodes++;
+            continue;
+        }
+
+        mesh_->bind();
+        shader_->bind();
+        glDrawElementsInstancedBaseInstance(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, command.instanceCount,
+            command.instanceStart);
+
+        /* Metrics */
+        stats_.drawCalls++;
+        stats_.batchedNodes += command.instanceCount;
+    }
+}
+
+void RectBatchRenderer::fillInstanceGeometry(RectInstanceData& data, const AbstractNode* node) const
+{
+    const auto& t = node->getTransform();
+    data.pos = t.pos;
+    data.scale = glm::vec2{t.scale.x, t.scale.y};
+    data.clipRect = glm::vec4{t.vPos.x, t.vPos.y, t.vScale.x, t.vScale.y};
+}
+} // namespace msgui::renderer
\ No newline at end of file
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "msgui/Logger.hpp"
+#include "msgui/Mesh.hpp"
+#include "msgui/Shader.hpp"
+#include "msgui/node/AbstractNode.hpp"
+#include "msgui/node/FrameNodeStore.hpp"
+#include "msgui/node/FrameState.hpp"
+#include "msgui/renderer/Types.hpp"
+
+namespace msgui::renderer
+{
+/* Class responsible for gathering nodes that can be drawn with the sdfRect shader into per instance buffers
+   and rendering them with as few draw calls as possible. Nodes that cannot be batched are rendered one by one
+   in between batches so that the back to front order is preserved.
+   The resulting list of draw commands is retained between frames and only rebuilt after it gets invalidated
+   (layout or node structure changes). */
+class RectBatchRenderer
+{
+public:
+    RectBatchRenderer();
+    ~RectBatchRenderer();
+
+    /**
+        Render the nodes back to front in as few batches as possible. If the command list is still valid, only
+        the instances of the damaged nodes are updated before replaying it.
+
+        @param nodes Store of the nodes to be rendered
+        @param projMat Orthographic projection matrix to be used
+        @param damageArea Damaged area of the frame along with the nodes that caused it
+    */
+    void render(const FrameNodeStore& nodes, const glm::mat4& projMat, const DamageArea& damageArea);
+
+    /**
+        Mark the retained command list as outdated. It will be rebuilt on the next render.
+    */
+    void invalidate();
+
+    /**
+        Get the rendering metrics of the last rendered frame.
+
+        @return Render metrics
+    */
+    const RenderStats& getStats() const;
+
+private:
+    /* Either a batch of instances or a single node that needs to be drawn on its own. */
+    struct DrawCommand
+    {
+        AbstractNodePtr node{nullptr};
+        int32_t instanceStart{0};
+        int32_t instanceCount{0};
+    };
+
+    /* Where the instance data of a batched node lives. Raw node is fine as the list is rebuilt whenever nodes
+       get removed. */
+    struct InstanceRef
+    {
+        AbstractNode* node{nullptr};
+        int32_t index{0};
+    };
+
+    /* Cannot be copied or moved */
+    RectBatchRenderer(const RectBatchRenderer&) = delete;
+    RectBatchRenderer(RectBatchRenderer&&) = delete;
+    RectBatchRenderer& operator=(const RectBatchRenderer&) = delete;
+    RectBatchRenderer& operator=(RectBatchRenderer&&) = delete;
+
+    void setupInstanceLayers();
+    void addInstanceLayer(const uint32_t index, const uint32_t count, const uint64_t offset);
+    void compileCommands(const FrameNodeStore& nodes);
+    void patchInstances(const std::vector<uint32_t>& nodeIds);
+    void replayCommands(const glm::mat4& projMat);
+    void fillInstanceGeometry(RectInstanceData& data, const AbstractNode* node) const;
+
+private:
+    Logger log_{"RectBatchRenderer"};
+    Mesh* mesh_{nullptr};
+    Shader* shader_{nullptr};
+    uint32_t instanceVboId_{0};
+    int64_t instanceVboCapacity_{0};
+    bool isInvalid_{true};
+    std::vector<RectInstanceData> instanceBuffer_;
+    std::vector<DrawCommand> commands_;
+    std::unordered_map<uint32_t, InstanceRef> nodeIdToInstance_;
+    RenderStats stats_;
+
+    static constexpr int32_t INSTANCE_LAYER_START{2};
+};
+} // namespace msgui::renderer
\ No newline at end of file
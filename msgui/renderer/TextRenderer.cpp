@@ -1,31 +1,39 @@
 #include "TextRenderer.hpp"
 
-#include "msgui/loaders/FontLoader.hpp"
+#include <algorithm>
+#include <cstddef>
+
 #include "msgui/loaders/MeshLoader.hpp"
 #include "msgui/loaders/ShaderLoader.hpp"
+#include "msgui/renderer/GlyphAtlas.hpp"
 #include "msgui/renderer/TextBufferStore.hpp"
 #include "msgui/renderer/Types.hpp"
+#include "msgui/renderer/Uniforms.hpp"
 
 namespace msgui::renderer
 {
 TextRenderer::TextRenderer()
 {
-    mesh_ = loaders::MeshLoader::loadQuad();
+    /* Quad needs its own vao as we attach the instanced attributes to it. */
+    mesh_ = loaders::MeshLoader::loadQuad("//iTextBatchQuadMesh");
     shader_ = loaders::ShaderLoader::loadShader("assets/shader/textInstanced.glsl");
-    fallbackFontTexId_ = loaders::FontLoader::get().loadFont(DEFAULT_FONT_PATH)->texId;
 
-    shaderBuffer_.transform.reserve(MAX_SHADER_BUFFER_SIZE);
-    shaderBuffer_.unicodeIndex.reserve(MAX_SHADER_BUFFER_SIZE);
+    setupInstanceLayers();
+    setupTextDataBuffer();
+}
+
+TextRenderer::~TextRenderer()
+{
+    glDeleteTextures(1, &textTboTexId_);
+    glDeleteBuffers(1, &textTboId_);
+    glDeleteBuffers(1, &glyphVboId_);
 }
 
-void TextRenderer::render(const glm::mat4& projMat, const int32_t frameHeight)
+void TextRenderer::render(const glm::mat4& projMat, const DamageArea& damageArea)
 {
     batchCount = 0;
 
-    mesh_->bind();
-    shader_->bind();
-    shader_->setMat4f("uProjMat", projMat);
-    shader_->setTexture2DArray("uTextureArray", GL_TEXTURE1, fallbackFontTexId_);
+    shader_->setMat4f(Uniforms::get().projMat, projMat);
     
     clearInternalBuffer();
 
@@ -35,51 +43,100 @@ void TextRenderer::render(const glm::mat4& projMat, const int32_t frameHeight)
         /* No point in rendering anything if the parent ain't event visible. */
         if (element.transformPtr->vScale.x <= 0 || element.transformPtr->vScale.y <= 0) { continue; }
 
-        doScissorMask(element.transformPtr, frameHeight);
-        
-        /* Use a fallback font in case the main one is not provided for some reason. */
-        element.fontData->texId
-            ? shader_->setTexture2DArray("uTextureArray", GL_TEXTURE1, element.fontData->texId)
-            : shader_->setTexture2DArray("uTextureArray", GL_TEXTURE1, fallbackFontTexId_);
-        shader_->setVec4f("uColor", element.color);
-
-        int32_t copiedSize = 0;
-        int32_t copyStart = 0;
-        int32_t copyEnd = 0;
-        while ((int32_t)element.pcd.transform.size() > copiedSize)
+        /* Text outside of the damaged area is still valid from the previous frame. */
+        if (!damageArea.intersects(element.transformPtr->vPos, element.transformPtr->vScale)) { continue; }
+        if (element.pcd.glyphs.empty()) { continue; }
+
+        /* Text index needs to fit in the upper half of each glyph's packed data. */
+        if ((int32_t)textBuffer_.size() >= MAX_TEXTS_PER_BATCH)
         {
-            int32_t spaceLeft = MAX_SHADER_BUFFER_SIZE - shaderBuffer_.transform.size();
-            copyEnd = copyStart + std::min(spaceLeft, (int32_t)element.pcd.transform.size());
-
-            std::copy(element.pcd.transform.begin() + copyStart, element.pcd.transform.begin() + copyEnd,
-                std::back_inserter(shaderBuffer_.transform));
-            std::copy(element.pcd.unicodeIndex.begin() + copyStart, element.pcd.unicodeIndex.begin() + copyEnd,
-                std::back_inserter(shaderBuffer_.unicodeIndex));
-
-            copiedSize += (copyEnd - copyStart);
-            copyStart = copyEnd;
-            
-            /* Render part of the text that made the buffer get full. */
-            if (shaderBuffer_.transform.size() >= MAX_SHADER_BUFFER_SIZE)
-            {
-                renderBatchContents();
-            }
+            renderBatchContents();
         }
 
-        /* In order to make use of glScissor we need to render one text buffer item per drawcall instead of
-           filling the shader buffer with many text buffer items.. */
-        if (shaderBuffer_.transform.size())
+        /* Clipping, color and font params are shared by all glyphs of the text so they are stored only once. */
+        const auto& tr = element.transformPtr;
+        const auto& font = element.fontData;
+        const uint32_t textIdxBits = textBuffer_.size() << 16;
+        textBuffer_.emplace_back(TextInstanceData{
+            .color = element.color,
+            .clipRect = glm::vec4{tr->vPos.x, tr->vPos.y, tr->vScale.x, tr->vScale.y},
+            .fontParams = glm::vec4{font->scale, font->isSdf ? 1.0f : 0.0f, 0.0f, 0.0f}
+        });
+
+        for (const auto& glyph : element.pcd.glyphs)
         {
-            renderBatchContents();
+            glyphBuffer_.emplace_back(GlyphInstanceData{
+                .pos = glyph.pos,
+                .glyphAndText = glyph.glyphAndText | textIdxBits});
         }
     }
+
+    /* Render whatever is left from the last text buffer items. */
+    renderBatchContents();
 };
 
+int32_t TextRenderer::getBatchCount() const { return batchCount; }
+
+void TextRenderer::setupInstanceLayers()
+{
+    mesh_->bind();
+
+    glGenBuffers(1, &glyphVboId_);
+    glBindBuffer(GL_ARRAY_BUFFER, glyphVboId_);
+
+    const uint32_t posIdx = INSTANCE_LAYER_START;
+    glVertexAttribPointer(posIdx, 3, GL_FLOAT, false, sizeof(GlyphInstanceData),
+        (void*)offsetof(GlyphInstanceData, pos));
+    glEnableVertexAttribArray(posIdx);
+    glVertexAttribDivisor(posIdx, 1);
+
+    /* Integer attribute, must not get converted to float. */
+    const uint32_t glyphAndTextIdx = INSTANCE_LAYER_START + 1;
+    glVertexAttribIPointer(glyphAndTextIdx, 1, GL_UNSIGNED_INT, sizeof(GlyphInstanceData),
+        (void*)offsetof(GlyphInstanceData, glyphAndText));
+    glEnableVertexAttribArray(glyphAndTextIdx);
+    glVertexAttribDivisor(glyphAndTextIdx, 1);
+}
+
+void TextRenderer::setupTextDataBuffer()
+{
+    glGenBuffers(1, &textTboId_);
+    glBindBuffer(GL_TEXTURE_BUFFER, textTboId_);
+
+    /* Texture views the buffer as a list of vec4s, each text taking up three of them. */
+    glGenTextures(1, &textTboTexId_);
+    glBindTexture(GL_TEXTURE_BUFFER, textTboTexId_);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, textTboId_);
+}
+
+void TextRenderer::uploadBuffer(const uint32_t target, const uint32_t bufferId, int64_t& capacity,
+    const void* data, const int64_t size)
+{
+    /* Orphan the previous storage so that we don't stall on draws that might still use it. */
+    capacity = std::max(capacity, size);
+    glBindBuffer(target, bufferId);
+    glBufferData(target, capacity, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(target, 0, size, data);
+}
+
 void TextRenderer::renderBatchContents()
 {
-    shader_->setMat4fv("uModelMatv",  shaderBuffer_.transform);
-    shader_->setIntv("uCharIdxv",  shaderBuffer_.unicodeIndex);
-    glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, shaderBuffer_.transform.size());
+    if (glyphBuffer_.empty()) { return; }
+
+    mesh_->bind();
+    /* Glyphs of every font and size live in the same atlas so one draw can hold all of them. */
+    const GlyphAtlas& atlas = GlyphAtlas::get();
+    const Uniforms& uniforms = Uniforms::get();
+    shader_->setTexture2D(uniforms.atlas, GL_TEXTURE1, atlas.getTexId());
+    shader_->setTextureBuffer(uniforms.textDatav, GL_TEXTURE2, textTboTexId_);
+    shader_->setTextureBuffer(uniforms.glyphRectv, GL_TEXTURE3, atlas.getRectsTexId());
+
+    uploadBuffer(GL_ARRAY_BUFFER, glyphVboId_, glyphVboCapacity_, glyphBuffer_.data(),
+        sizeof(GlyphInstanceData) * glyphBuffer_.size());
+    uploadBuffer(GL_TEXTURE_BUFFER, textTboId_, textTboCapacity_, textBuffer_.data(),
+        sizeof(TextInstanceData) * textBuffer_.size());
+
+    glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, glyphBuffer_.size());
 
     /* Metrics */
     batchCount++;
@@ -89,16 +146,7 @@ void TextRenderer::renderBatchContents()
 
 void TextRenderer::clearInternalBuffer()
 {
-    shaderBuffer_.transform.clear();
-    shaderBuffer_.unicodeIndex.clear();
-}
-
-void TextRenderer::doScissorMask(const utils::TransformPtr tr, const int32_t frameHeight)
-{
-    glScissor(
-        tr->vPos.x,
-        frameHeight - tr->vPos.y - tr->vScale.y,
-        tr->vScale.x,
-        tr->vScale.y);
+    glyphBuffer_.clear();
+    textBuffer_.clear();
 }
 } // namespace msgui::renderer
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include <GL/glew.h>
 #include <glm/glm.hpp>
 
@@ -7,6 +9,7 @@
 #include "msgui/Mesh.hpp"
 #include "msgui/Shader.hpp"
 #include "msgui/layoutEngine/utils/Transform.hpp"
+#include "msgui/node/FrameState.hpp"
 #include "msgui/renderer/Types.hpp"
 
 namespace msgui::renderer
@@ -18,8 +21,22 @@ class TextRenderer
 {
 public:
     TextRenderer();
+    ~TextRenderer();
+
+    /**
+        Render all the text buffers that overlap the damaged area.
+
+        @param projMat Orthographic projection matrix to be used
+        @param damageArea Area of the frame that needs redrawing
+    */
+    void render(const glm::mat4& projMat, const DamageArea& damageArea);
+
+    /**
+        Get the number of draw calls issued during the last render.
 
-    void render(const glm::mat4& projMat, const int32_t frameHeight);
+        @return Number of draw calls
+    */
+    int32_t getBatchCount() const;
 
 private:
     /* Cannot be copied or moved */
@@ -28,19 +45,28 @@ private:
     TextRenderer& operator=(const TextRenderer&) = delete;
     TextRenderer& operator=(TextRenderer&&) = delete;
 
+    void setupInstanceLayers();
+    void setupTextDataBuffer();
+    void uploadBuffer(const uint32_t target, const uint32_t bufferId, int64_t& capacity, const void* data,
+        const int64_t size);
     void renderBatchContents();
     void clearInternalBuffer();
-    void doScissorMask(const utils::TransformPtr tr, const int32_t frameHeight);
 
 private:
     Logger log_{"TextRenderer"};
-    int32_t fallbackFontTexId_{0};
     Mesh* mesh_{nullptr};
     Shader* shader_{nullptr};
     glm::vec4 color_{1.0f};
-    PerCodepointData shaderBuffer_;
+    std::vector<GlyphInstanceData> glyphBuffer_;
+    std::vector<TextInstanceData> textBuffer_;
+    uint32_t glyphVboId_{0};
+    int64_t glyphVboCapacity_{0};
+    uint32_t textTboId_{0};
+    uint32_t textTboTexId_{0};
+    int64_t textTboCapacity_{0};
     int32_t batchCount{0};
 
-    static constexpr int32_t MAX_SHADER_BUFFER_SIZE{256};
+    static constexpr int32_t MAX_TEXTS_PER_BATCH{1 << 16};
+    static constexpr int32_t INSTANCE_LAYER_START{2};
 };
 } // namespace msgui::renderer
\ No newline at end of file
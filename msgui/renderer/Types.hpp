@@ -14,10 +14,18 @@ namespace msgui::renderer
 {
 using namespace msgui::layoutengine;
 
+/* Per glyph data of a text, packed to 16 bytes. Holds the top left position of the glyph plus the glyph atlas slot
+   (low 16 bits) and the index of the text it belongs to inside the current draw (high 16 bits). Layout needs to
+   match the instanced attributes of the textInstanced shader. */
+struct GlyphInstanceData
+{
+    glm::vec3 pos{0};
+    uint32_t glyphAndText{0};
+};
+
 struct PerCodepointData
 {
-    std::vector<glm::mat4> transform;
-    std::vector<int32_t> unicodeIndex;
+    std::vector<GlyphInstanceData> glyphs;
 };
 
 struct TextData
@@ -29,9 +37,42 @@ struct TextData
     FontPtr fontData{nullptr};
     utils::Transform* transformPtr{nullptr};
     glm::ivec2 textBounds{0, 0};
+    glm::vec3 laidOutPos{-1};   /* Node position & scale the glyphs were last laid out for */
+    glm::vec3 laidOutScale{-1};
     // other data
 };
 
+/* Per instance data of a node drawn by the batch renderer. Layout needs to match the instanced attributes
+   of the sdfRectInstanced shader. */
+struct RectInstanceData
+{
+    glm::vec3 pos{0};
+    glm::vec2 scale{0};
+    glm::vec4 color{1.0f};
+    glm::vec4 borderColor{1.0f};
+    glm::vec4 borderSize{0};
+    glm::vec4 borderRadii{0};
+    glm::vec4 clipRect{0};
+};
+
+/* Per text data shared by all of its glyphs. Stored in a texture buffer and fetched by the textInstanced shader
+   using the text index of each glyph. */
+struct TextInstanceData
+{
+    glm::vec4 color{1.0f};
+    glm::vec4 clipRect{0};
+    glm::vec4 fontParams{1.0f, 0.0f, 0.0f, 0.0f}; /* Glyph scale & whether glyphs are distance fields */
+};
+
+/* Per frame rendering metrics. */
+struct RenderStats
+{
+    int32_t drawCalls{0};
+    int32_t batchedNodes{0};
+    int32_t unbatchedNodes{0};
+    int32_t patchedNodes{0};
+};
+
 using TextDataList = std::list<TextData>;
 using TextDataListIt = TextDataList::iterator;
 using MaybeTextDataIt = std::optional<TextDataListIt>;
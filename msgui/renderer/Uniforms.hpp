@@ -0,0 +1,31 @@
+#pragma once
+
+#include "msgui/Shader.hpp"
+
+namespace msgui::renderer
+{
+/* Handles of the uniforms set every frame by the renderers and by nodes drawing themselves. Resolved once, they work
+   with any shader declaring the uniform. */
+struct Uniforms
+{
+    static const Uniforms& get()
+    {
+        static const Uniforms uniforms;
+        return uniforms;
+    }
+
+    const UniformId projMat{Shader::getUniformId("uProjMat")};
+    const UniformId clipRect{Shader::getUniformId("uClipRect")};
+    const UniformId modelMat{Shader::getUniformId("uModelMat")};
+    const UniformId color{Shader::getUniformId("uColor")};
+    const UniformId borderColor{Shader::getUniformId("uBorderColor")};
+    const UniformId borderSize{Shader::getUniformId("uBorderSize")};
+    const UniformId borderRadii{Shader::getUniformId("uBorderRadii")};
+    const UniformId resolution{Shader::getUniformId("uResolution")};
+    const UniformId useTexture{Shader::getUniformId("uUseTexture")};
+    const UniformId texture{Shader::getUniformId("uTexture")};
+    const UniformId atlas{Shader::getUniformId("uAtlas")};
+    const UniformId textDatav{Shader::getUniformId("uTextDatav")};
+    const UniformId glyphRectv{Shader::getUniformId("uGlyphRectv")};
+};
+} // namespace msgui::renderer